@@ -0,0 +1,43 @@
+#include "Change_set.h"
+
+using namespace std;
+
+Change_set::Change_set()
+{}
+
+void
+Change_set::set_removed(int id)
+{
+    // changes before the removal no longer matter
+    Change& change = get_change(id, REMOVED);
+    change.mask = REMOVED;
+}
+
+void
+Change_set::clear()
+{
+    for (const Change& change : changes)
+    {
+        change_index[change.id] = -1;
+    }
+    changes.clear();
+}
+
+Change_set::Change&
+Change_set::get_change(int id, unsigned field)
+{
+    if (id >= static_cast<int>(change_index.size()))
+    {
+        change_index.resize(id + 1, -1);
+    }
+
+    if (change_index[id] == -1)
+    {
+        change_index[id] = static_cast<int>(changes.size());
+        changes.push_back({id, 0, Point(), 0., 0., 0., 0});
+    }
+
+    Change& change = changes[change_index[id]];
+    change.mask |= field;
+    return change;
+}
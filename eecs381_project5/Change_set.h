@@ -0,0 +1,84 @@
+#ifndef CHANGE_SET_H
+#define CHANGE_SET_H
+
+/***************************************************************************
+    A Change_set collects the changes to objects' location, fuel,
+    speed, course and movement state, and their removal, so that they can be given
+    to a View all at once.
+    There is one entry per object, in the order in which each
+    object first changed; the entry has a mask of which fields
+    changed and the latest value of each, so writing the same
+    field again just replaces the value.
+    A removal discards the field changes recorded before it;
+    when an entry is applied, the removal comes first,
+    then any field changes recorded after it.
+***************************************************************************/
+
+#include "Geometry.h"
+#include <vector>
+
+class Change_set
+{
+  public:
+      // bits of the mask of changed fields
+      enum Field_e
+      {
+          LOCATION = 1,
+          FUEL     = 2,
+          SPEED    = 4,
+          COURSE   = 8,
+          REMOVED  = 16,
+          STATE    = 32
+      };
+
+      struct Change
+      {
+          int id;
+          unsigned mask;
+          Point location;
+          double fuel;
+          double speed;
+          double course;
+          int state;
+      };
+
+      typedef std::vector<Change>::const_iterator const_iterator;
+
+      Change_set();
+
+      // record a change for the object with the id
+      void set_location(int id, Point location)
+          {Change& change = get_change(id, LOCATION); change.location = location;}
+      void set_fuel(int id, double fuel)
+          {Change& change = get_change(id, FUEL); change.fuel = fuel;}
+      void set_speed(int id, double speed)
+          {Change& change = get_change(id, SPEED); change.speed = speed;}
+      void set_course(int id, double course)
+          {Change& change = get_change(id, COURSE); change.course = course;}
+      void set_state(int id, int state)
+          {Change& change = get_change(id, STATE); change.state = state;}
+      void set_removed(int id);
+
+      // the entries, in the order the objects first changed
+      const_iterator begin() const
+          {return changes.begin();}
+      const_iterator end() const
+          {return changes.end();}
+      bool empty() const
+          {return changes.empty();}
+
+      // discard all of the entries
+      void clear();
+
+  private:
+      std::vector<Change> changes;
+
+      // position of each id's entry in changes, or -1 if it has none
+      std::vector<int> change_index;
+
+      // return the entry for the id, creating it if needed,
+      // with the field marked as changed
+      Change& get_change(int id, unsigned field);
+};
+
+#endif
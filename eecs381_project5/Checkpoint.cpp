@@ -0,0 +1,261 @@
+#include "Checkpoint.h"
+#include "Island.h"
+#include "Ship.h"
+#include "Utility.h"
+#include <fstream>
+#include <cstring>
+
+using namespace std;
+
+// first and last bytes of every checkpoint file
+const char checkpoint_magic[4] = {'P', '5', 'C', 'K'};
+
+Checkpoint_writer::Checkpoint_writer()
+{
+    write_bytes(checkpoint_magic, sizeof(checkpoint_magic));
+    write_bytes(&checkpoint_version, sizeof(checkpoint_version));
+}
+
+void
+Checkpoint_writer::write_int(int32_t value)
+{
+    write_bytes(&value, sizeof(value));
+}
+
+void
+Checkpoint_writer::write_double(double value)
+{
+    write_bytes(&value, sizeof(value));
+}
+
+void
+Checkpoint_writer::write_point(Point point)
+{
+    write_double(point.x);
+    write_double(point.y);
+}
+
+void
+Checkpoint_writer::write_string(const string& value)
+{
+    write_int(static_cast<int32_t>(value.size()));
+    write_bytes(value.data(), value.size());
+}
+
+void
+Checkpoint_writer::write_island(shared_ptr<Island> island_ptr)
+{
+    write_int(island_ptr ? island_ptr->get_id() : -1);
+}
+
+void
+Checkpoint_writer::write_ship(shared_ptr<Ship> ship_ptr)
+{
+    write_int(ship_ptr ? ship_ptr->get_id() : -1);
+}
+
+void
+Checkpoint_writer::save(const string& file_name)
+{
+    write_bytes(checkpoint_magic, sizeof(checkpoint_magic));
+
+    ofstream file(file_name.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!file || !file.write(&buffer[0], buffer.size()))
+    {
+        throw Error("Could not write checkpoint file!");
+    }
+}
+
+void
+Checkpoint_writer::write_bytes(const void* bytes, size_t size)
+{
+    const char* first = static_cast<const char*>(bytes);
+    buffer.insert(buffer.end(), first, first + size);
+}
+
+Checkpoint_reader::Checkpoint_reader(const string& file_name) :
+    position(0),
+    end(0)
+{
+    ifstream file(file_name.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+        throw Error("Could not read checkpoint file!");
+    }
+
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    file.seekg(0, ios::beg);
+    if (size < 0)
+    {
+        throw Error("Could not read checkpoint file!");
+    }
+
+    buffer.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(&buffer[0], size))
+    {
+        throw Error("Could not read checkpoint file!");
+    }
+
+    // the magic number must be at both ends
+    size_t header_size = sizeof(checkpoint_magic) + sizeof(checkpoint_version);
+    if (buffer.size() < header_size + sizeof(checkpoint_magic) ||
+        memcmp(&buffer[0], checkpoint_magic, sizeof(checkpoint_magic)) ||
+        memcmp(&buffer[buffer.size() - sizeof(checkpoint_magic)],
+               checkpoint_magic,
+               sizeof(checkpoint_magic)))
+    {
+        throw Error("Not a checkpoint file!");
+    }
+
+    uint32_t version;
+    memcpy(&version, &buffer[sizeof(checkpoint_magic)], sizeof(version));
+    if (version != checkpoint_version)
+    {
+        throw Error("Unsupported checkpoint version!");
+    }
+
+    position = header_size;
+    end      = buffer.size() - sizeof(checkpoint_magic);
+}
+
+int32_t
+Checkpoint_reader::read_int()
+{
+    int32_t value;
+    read_bytes(&value, sizeof(value));
+    return value;
+}
+
+double
+Checkpoint_reader::read_double()
+{
+    double value;
+    read_bytes(&value, sizeof(value));
+    return value;
+}
+
+Point
+Checkpoint_reader::read_point()
+{
+    double x = read_double();
+    double y = read_double();
+    return Point(x, y);
+}
+
+string
+Checkpoint_reader::read_string()
+{
+    int32_t size = read_int();
+    if (size < 0 || static_cast<size_t>(size) > end - position)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+
+    string value(&buffer[position], size);
+    position += size;
+    return value;
+}
+
+void
+Checkpoint_reader::add_id(int saved_id, int new_id)
+{
+    if (saved_id < 0)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    if (saved_id >= static_cast<int>(new_ids.size()))
+    {
+        new_ids.resize(saved_id + 1, -1);
+    }
+    new_ids[saved_id] = new_id;
+}
+
+int
+Checkpoint_reader::read_id()
+{
+    return translate_id(read_int());
+}
+
+int
+Checkpoint_reader::translate_id(int32_t saved_id) const
+{
+    if (saved_id < 0 ||
+        saved_id >= static_cast<int>(new_ids.size()) ||
+        new_ids[saved_id] == -1)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    return new_ids[saved_id];
+}
+
+void
+Checkpoint_reader::add_island(shared_ptr<Island> island_ptr)
+{
+    check_new_object(island_ptr->get_id());
+    islands[island_ptr->get_id()] = island_ptr;
+}
+
+void
+Checkpoint_reader::add_ship(shared_ptr<Ship> ship_ptr)
+{
+    check_new_object(ship_ptr->get_id());
+    ships[ship_ptr->get_id()] = ship_ptr;
+}
+
+shared_ptr<Island>
+Checkpoint_reader::read_island()
+{
+    int32_t saved_id = read_int();
+    if (saved_id == -1)
+    {
+        return nullptr;
+    }
+    int id = translate_id(saved_id);
+    if (id >= static_cast<int>(islands.size()) || !islands[id])
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    return islands[id];
+}
+
+shared_ptr<Ship>
+Checkpoint_reader::read_ship()
+{
+    int32_t saved_id = read_int();
+    if (saved_id == -1)
+    {
+        return nullptr;
+    }
+    int id = translate_id(saved_id);
+    if (id >= static_cast<int>(ships.size()) || !ships[id])
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    return ships[id];
+}
+
+void
+Checkpoint_reader::check_new_object(int id)
+{
+    if (id >= static_cast<int>(islands.size()))
+    {
+        islands.resize(id + 1);
+        ships.resize(id + 1);
+    }
+    if (islands[id] || ships[id])
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+}
+
+void
+Checkpoint_reader::read_bytes(void* bytes, size_t size)
+{
+    if (size > end - position)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    memcpy(bytes, &buffer[position], size);
+    position += size;
+}
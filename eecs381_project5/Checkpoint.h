@@ -0,0 +1,115 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/***************************************************************************
+    A checkpoint is a binary file holding the whole state of the Model,
+    so that a simulation can be saved and later restored exactly.
+    Checkpoint_writer collects the values in memory and writes the
+    file all at once; Checkpoint_reader reads the whole file into
+    memory and hands the values back in the same order.
+    Numbers are kept in the byte order of the host,
+    and doubles exactly as they are in memory.
+
+    The file starts with a magic number and a version, and ends with
+    the magic number again, so that a truncated file is noticed before
+    the Model is changed. Objects are referred to by the id of their
+    name when the file was saved; the names are saved with their ids,
+    and the reader translates a saved id into the id the name has now.
+***************************************************************************/
+
+#include "Geometry.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class Island;
+class Ship;
+
+// version of the layout of the file
+const std::uint32_t checkpoint_version = 1;
+
+class Checkpoint_writer
+{
+  public:
+      Checkpoint_writer();
+
+      void write_int(std::int32_t);
+      void write_double(double);
+      void write_point(Point);
+      void write_string(const std::string&);
+
+      // an object is written as its id, or -1 for none
+      void write_island(std::shared_ptr<Island>);
+      void write_ship(std::shared_ptr<Ship>);
+
+      // add the final magic number and write everything to the file
+      // will throw Error("Could not write checkpoint file!")
+      void save(const std::string& file_name);
+
+  private:
+      std::vector<char> buffer;
+
+      void write_bytes(const void*, std::size_t);
+};
+
+class Checkpoint_reader
+{
+  public:
+      // read and check the whole file
+      // will throw Error("Could not read checkpoint file!")
+      // or Error("Not a checkpoint file!")
+      // or Error("Unsupported checkpoint version!")
+      explicit Checkpoint_reader(const std::string& file_name);
+
+      // these will throw Error("Checkpoint file is damaged!")
+      // if the file has ended
+      std::int32_t read_int();
+      double read_double();
+      Point read_point();
+      std::string read_string();
+
+      // record that the name saved with the id now has the id new_id
+      void add_id(int saved_id, int new_id);
+
+      // the id an object saved with the id has now;
+      // will throw Error("Checkpoint file is damaged!")
+      // if there was no such name
+      int read_id();
+
+      // record an object made from the file, by the id it has now;
+      // will throw Error("Checkpoint file is damaged!")
+      // if an object with that id has already been recorded
+      void add_island(std::shared_ptr<Island>);
+      void add_ship(std::shared_ptr<Ship>);
+
+      // read an id written for an object, and return the object
+      // recorded with it, or nullptr if none was written;
+      // will throw Error("Checkpoint file is damaged!")
+      // if no object of that kind was recorded with the id
+      std::shared_ptr<Island> read_island();
+      std::shared_ptr<Ship> read_ship();
+
+  private:
+      std::vector<char> buffer;
+      std::size_t position;
+      std::size_t end;
+
+      // new ids, indexed by saved id, -1 if unknown
+      std::vector<int> new_ids;
+
+      // the objects made from the file, indexed by the id they have now
+      std::vector<std::shared_ptr<Island>> islands;
+      std::vector<std::shared_ptr<Ship>> ships;
+
+      // make room in islands and ships for the id, and check
+      // that no object has been recorded with it
+      void check_new_object(int id);
+
+      void read_bytes(void*, std::size_t);
+
+      // the id a saved id now has
+      int translate_id(std::int32_t) const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "Command_journal.h"
+#include "Utility.h"
+
+using namespace std;
+
+Command_journal::Command_journal(const string& file_name) :
+    file(file_name.c_str(), ios::out | ios::trunc)
+{
+    if (!file)
+    {
+        throw Error("Could not open journal file!");
+    }
+}
+
+// the command is written without the blanks around it,
+// and with any newlines inside it made into spaces
+void
+Command_journal::write_command(int time, const string& text)
+{
+    const char* blanks = " \t\r\n";
+    string::size_type first = text.find_first_not_of(blanks);
+    if (first == string::npos)
+    {
+        return;
+    }
+    string::size_type last = text.find_last_not_of(blanks);
+
+    string command = text.substr(first, last - first + 1);
+    for (char& c : command)
+    {
+        if (c == '\n' || c == '\r')
+        {
+            c = ' ';
+        }
+    }
+
+    file << time << ' ' << command << '\n';
+    file.flush();
+}
@@ -0,0 +1,37 @@
+#ifndef COMMAND_JOURNAL_H
+#define COMMAND_JOURNAL_H
+
+/***************************************************************************
+    A Command_journal writes each command the Controller accepted to
+    a file, one per line, after the time it ran at:
+        12 Ajax course 90 10
+    The Controller gives it the text of the command exactly as it was
+    read, however many lines it took.
+    A journal can be fed back to the Controller with its replay command.
+    Only the commands that succeed are journaled. A command that fails
+    leaves the Model as it was, so a replay is still exact without it.
+***************************************************************************/
+
+#include <fstream>
+#include <string>
+
+class Command_journal
+{
+  public:
+      // will throw Error("Could not open journal file!")
+      explicit Command_journal(const std::string& file_name);
+
+      // forbid copy/move, construction/assignment
+      Command_journal(const Command_journal&) = delete;
+      Command_journal(Command_journal&&) = delete;
+      Command_journal& operator= (const Command_journal&) = delete;
+      Command_journal& operator= (Command_journal&&) = delete;
+
+      // write the text of a command that ran at the time
+      void write_command(int time, const std::string& text);
+
+  private:
+      std::ofstream file;
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "Command_reader.h"
+#include <iostream>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// number of characters asked for by each read from a file descriptor
+const size_t block_size = 1 << 16;
+
+// a regular file is mapped whole, starting from where
+// the descriptor has got to, and needs no reading at all
+Command_reader::Command_reader(int file_descriptor_) :
+    file_descriptor(file_descriptor_),
+    data(nullptr),
+    mapping(nullptr),
+    mapping_size(0),
+    position(0),
+    filled(0),
+    command_start(0),
+    ended(false)
+{
+    struct stat file_status;
+    off_t offset = lseek(file_descriptor, 0, SEEK_CUR);
+    if (fstat(file_descriptor, &file_status) == 0 &&
+        S_ISREG(file_status.st_mode) &&
+        file_status.st_size > 0 &&
+        offset >= 0)
+    {
+        void* address = mmap(nullptr,
+                             file_status.st_size,
+                             PROT_READ,
+                             MAP_PRIVATE,
+                             file_descriptor,
+                             0);
+        if (address != MAP_FAILED)
+        {
+            mapping       = address;
+            mapping_size  = file_status.st_size;
+            data          = static_cast<const char*>(mapping);
+            filled        = mapping_size;
+            position      = (static_cast<size_t>(offset) < filled) ?
+                            static_cast<size_t>(offset) : filled;
+            command_start = position;
+            ended         = true;
+            return;
+        }
+    }
+
+    buffer.resize(block_size);
+    data = &buffer[0];
+}
+
+Command_reader::Command_reader(const string& text) :
+    file_descriptor(-1),
+    buffer(text.begin(), text.end()),
+    data(nullptr),
+    mapping(nullptr),
+    mapping_size(0),
+    position(0),
+    filled(text.size()),
+    command_start(0),
+    ended(true)
+{
+    buffer.push_back('\0');
+    data = &buffer[0];
+}
+
+Command_reader::~Command_reader()
+{
+    if (mapping)
+    {
+        munmap(mapping, mapping_size);
+    }
+}
+
+bool
+Command_reader::read_word(string& word)
+{
+    if (!skip_whitespace())
+    {
+        word.clear();
+        return false;
+    }
+
+    size_t length = 1;
+    int c;
+    while ((c = peek(length)) != EOF && !isspace(c))
+    {
+        ++length;
+    }
+
+    word.assign(data + position, length);
+    position += length;
+    return true;
+}
+
+bool
+Command_reader::read_double(double& value)
+{
+    if (!skip_whitespace())
+    {
+        return false;
+    }
+
+    size_t length = scan_number(true);
+    if (length == 0)
+    {
+        return false;
+    }
+
+    // strtod needs the number to end with a null character;
+    // a number too large for a double is a failed read, as it is
+    // for >>, but one too small to tell from zero reads as zero
+    string number(data + position, length);
+    position += length;
+    errno = 0;
+    double result = strtod(number.c_str(), nullptr);
+    if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL))
+    {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+// a number too large for an int is a failed read, as it is for >>
+bool
+Command_reader::read_int(int& value)
+{
+    if (!skip_whitespace())
+    {
+        return false;
+    }
+
+    size_t length = scan_number(false);
+    if (length == 0)
+    {
+        return false;
+    }
+
+    string number(data + position, length);
+    position += length;
+    errno = 0;
+    long result = strtol(number.c_str(), nullptr, 10);
+    if (errno == ERANGE || result < INT_MIN || result > INT_MAX)
+    {
+        return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+int
+Command_reader::peek_on_line()
+{
+    int c;
+    while ((c = peek()) == ' ' || c == '\t')
+    {
+        ++position;
+    }
+    return (c == '\n') ? EOF : c;
+}
+
+void
+Command_reader::skip_line()
+{
+    int c;
+    while ((c = peek()) != EOF)
+    {
+        ++position;
+        if (c == '\n')
+        {
+            return;
+        }
+    }
+}
+
+// the characters from the start of the command on are kept,
+// moved to the front of the buffer, and the buffer grows
+// if a command does not fit in what is left of it
+bool
+Command_reader::fill()
+{
+    if (ended)
+    {
+        return false;
+    }
+
+    // as cin is tied to cout, what has been written is shown
+    // before waiting for input
+    cout.flush();
+
+    if (command_start > 0)
+    {
+        memmove(&buffer[0], &buffer[command_start], filled - command_start);
+        filled -= command_start;
+        position -= command_start;
+        command_start = 0;
+    }
+    if (buffer.size() - filled < block_size)
+    {
+        buffer.resize(filled + block_size);
+    }
+    data = &buffer[0];
+
+    ssize_t count;
+    do
+    {
+        count = read(file_descriptor, &buffer[filled], buffer.size() - filled);
+    }
+    while (count < 0 && errno == EINTR);
+
+    if (count <= 0)
+    {
+        ended = true;
+        return false;
+    }
+    filled += count;
+    return true;
+}
+
+bool
+Command_reader::fill_to(size_t offset)
+{
+    while (position + offset >= filled)
+    {
+        if (!fill())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+Command_reader::skip_whitespace()
+{
+    int c;
+    while ((c = peek()) != EOF && isspace(c))
+    {
+        ++position;
+    }
+    return (c != EOF);
+}
+
+// a number is an optional sign and digits, and for a double,
+// a fraction and an exponent, which must have digits of its own
+size_t
+Command_reader::scan_number(bool fraction)
+{
+    size_t length = 0;
+    size_t num_digits = 0;
+
+    if (peek() == '+' || peek() == '-')
+    {
+        ++length;
+    }
+    while (isdigit(peek(length)))
+    {
+        ++length;
+        ++num_digits;
+    }
+
+    if (fraction)
+    {
+        if (peek(length) == '.')
+        {
+            ++length;
+            while (isdigit(peek(length)))
+            {
+                ++length;
+                ++num_digits;
+            }
+        }
+
+        if (num_digits > 0 && (peek(length) == 'e' || peek(length) == 'E'))
+        {
+            size_t exponent = length + 1;
+            if (peek(exponent) == '+' || peek(exponent) == '-')
+            {
+                ++exponent;
+            }
+            if (isdigit(peek(exponent)))
+            {
+                length = exponent;
+                while (isdigit(peek(length)))
+                {
+                    ++length;
+                }
+            }
+        }
+    }
+
+    return (num_digits > 0) ? length : 0;
+}
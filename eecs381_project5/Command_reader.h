@@ -0,0 +1,103 @@
+#ifndef COMMAND_READER_H
+#define COMMAND_READER_H
+
+/***************************************************************************
+    A Command_reader splits the input of the Controller into words
+    and numbers, the way reading them from cin with >> would:
+    blanks and newlines before a word or number are skipped, a number
+    is read as far as it looks like one, and a failed read takes
+    nothing but the whitespace before it.
+    Instead of going through an istream for every word, it reads
+    its input in large blocks into a buffer, or maps the whole of it
+    if it is a regular file, and finds each word in place; only the
+    word asked for is copied out. Numbers are converted with the
+    C library from the characters found.
+    Reading from a file descriptor flushes cout first, as cin would,
+    so a prompt is shown before the program waits for a command.
+    The reader also keeps the text of the command being read,
+    from the point marked by begin_command, for the journal.
+***************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+
+class Command_reader
+{
+  public:
+      // read from a file descriptor, which is left open
+      explicit Command_reader(int file_descriptor);
+
+      // read the text of a single command, such as a line of a journal
+      explicit Command_reader(const std::string& text);
+
+      ~Command_reader();
+
+      // forbid copy/move, construction/assignment
+      Command_reader(const Command_reader&) = delete;
+      Command_reader(Command_reader&&) = delete;
+      Command_reader& operator= (const Command_reader&) = delete;
+      Command_reader& operator= (Command_reader&&) = delete;
+
+      // read the next word; return false if the input has ended
+      bool read_word(std::string&);
+
+      // read the next number; return false if the next word
+      // does not start with one
+      bool read_double(double&);
+      bool read_int(int&);
+
+      // skip spaces and tabs, and return the next character,
+      // or EOF if the line or the input has ended
+      int peek_on_line();
+
+      // skip the rest of the line, including the newline
+      void skip_line();
+
+      // start keeping the text of a command at the current point
+      void begin_command()
+          {command_start = position;}
+
+      // the text read since begin_command
+      std::string get_command_text() const
+          {return std::string(data + command_start, data + position);}
+
+  private:
+      int file_descriptor;
+
+      // the characters read so far, from the start of the command;
+      // data points into buffer, or at the mapped file
+      std::vector<char> buffer;
+      const char* data;
+      void* mapping;
+      std::size_t mapping_size;
+
+      std::size_t position;
+      std::size_t filled;
+      std::size_t command_start;
+      bool ended;
+
+      // read more characters, discarding those before the command;
+      // return false if there are no more
+      bool fill();
+
+      // return the character at an offset from the current position
+      // without taking it, or EOF if the input ends before it
+      int peek(std::size_t offset = 0)
+          {return (position + offset < filled || fill_to(offset)) ?
+                  static_cast<unsigned char>(data[position + offset]) : EOF;}
+
+      // fill until the offset from the current position has been read
+      bool fill_to(std::size_t offset);
+
+      // skip spaces, tabs and newlines; return false if the input has ended
+      bool skip_whitespace();
+
+      // the length of the number that starts at the current position,
+      // reading more characters if it reaches the end of those read;
+      // zero if there is none
+      std::size_t scan_number(bool fraction);
+};
+
+#endif
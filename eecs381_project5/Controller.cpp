@@ -5,82 +5,167 @@
 #include "Ship.h"
 #include "Island.h"
 #include "Ship_factory.h"
+#include "Output.h"
+#include "Trajectory_recorder.h"
+#include "Telemetry_view.h"
+#include "Command_journal.h"
+#include "Command_reader.h"
+#include "Scenario.h"
+#include "Renderer.h"
+#include "Name_table.h"
 #include "Utility.h"
 #include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <cstdint>
+#include <unistd.h>
 
 using namespace std;
 
-typedef map<string, void (Controller::*)()> No_Arg_Map_t;
-typedef map<string, void (Controller::*)(shared_ptr<Ship>)> Ship_Arg_Map_t;
-typedef map<string, void (Controller::*)(shared_ptr<View>)> View_Arg_Map_t;
-
-Controller::Controller()
-{
-    // populate the functions needing a ship pointer arg
-    ship_command_map["course"] = &Controller::ship_course;
-    ship_command_map["position"] = &Controller::ship_position;
-    ship_command_map["destination"] = &Controller::ship_destination;
-    ship_command_map["load_at"] = &Controller::ship_load_at;
-    ship_command_map["unload_at"] = &Controller::ship_unload_at;
-    ship_command_map["dock_at"] = &Controller::ship_dock_at;
-    ship_command_map["attack"] = &Controller::ship_attack;
-    ship_command_map["refuel"] = &Controller::ship_refuel;
-    ship_command_map["stop"] = &Controller::ship_stop;
-    ship_command_map["stop_attack"] = &Controller::ship_stop_attack;
-    
-    // populate the functions for map
-    map_command_map["default"] = &Controller::view_default;
-    map_command_map["size"] = &Controller::view_size;
-    map_command_map["zoom"] = &Controller::view_zoom;
-    map_command_map["pan"] = &Controller::view_pan;
-    map_command_map["open_map_view"] = &Controller::open_map_view;
-    map_command_map["close_map_view"] = &Controller::close_map_view;
-    
-    // populate the functions for sailing
-    sailing_command_map["open_sailing_view"] = &Controller::open_sailing_view;
-    sailing_command_map["close_sailing_view"] = &Controller::close_sailing_view;
-    
-    // populate the functions for bridge
-    no_arg_command_map["open_bridge_view"] = &Controller::open_bridge_view;
-    no_arg_command_map["close_bridge_view"] = &Controller::close_bridge_view;
-
-    // populate the functions needing no args
-    no_arg_command_map["show"] = &Controller::view_show;
-    no_arg_command_map["status"] = &Controller::model_status;
-    no_arg_command_map["go"] = &Controller::model_go;
-    no_arg_command_map["create"] = &Controller::model_create;
-    
+// commands are found by their FNV-1a hash, whose top bits index
+// a table; the seed is one under which no two commands share a slot
+const uint32_t command_hash_seed = 6685;
+const int command_slot_bits = 7;
+const int command_table_size = 1 << command_slot_bits;
+
+constexpr uint32_t command_hash(const char* word, uint32_t hash)
+{
+    return *word ?
+           command_hash(word + 1,
+                        (hash ^ static_cast<unsigned char>(*word)) * 16777619u) :
+           hash;
 }
 
-Controller::~Controller()
+constexpr int command_slot(const char* word)
+{
+    return command_hash(word, command_hash_seed) >> (32 - command_slot_bits);
+}
+
+constexpr Controller::Command_entry Controller::command_entries[] =
+{
+    // ship commands
+    {"course", SHIP_COMMAND, nullptr, &Controller::ship_course, nullptr},
+    {"position", SHIP_COMMAND, nullptr, &Controller::ship_position, nullptr},
+    {"destination", SHIP_COMMAND, nullptr, &Controller::ship_destination, nullptr},
+    {"load_at", SHIP_COMMAND, nullptr, &Controller::ship_load_at, nullptr},
+    {"unload_at", SHIP_COMMAND, nullptr, &Controller::ship_unload_at, nullptr},
+    {"dock_at", SHIP_COMMAND, nullptr, &Controller::ship_dock_at, nullptr},
+    {"attack", SHIP_COMMAND, nullptr, &Controller::ship_attack, nullptr},
+    {"refuel", SHIP_COMMAND, nullptr, &Controller::ship_refuel, nullptr},
+    {"stop", SHIP_COMMAND, nullptr, &Controller::ship_stop, nullptr},
+    {"stop_attack", SHIP_COMMAND, nullptr, &Controller::ship_stop_attack, nullptr},
+
+    // map commands
+    {"default", MAP_COMMAND, nullptr, nullptr, &Controller::view_default},
+    {"size", MAP_COMMAND, nullptr, nullptr, &Controller::view_size},
+    {"zoom", MAP_COMMAND, nullptr, nullptr, &Controller::view_zoom},
+    {"pan", MAP_COMMAND, nullptr, nullptr, &Controller::view_pan},
+    {"large_size", MAP_COMMAND, nullptr, nullptr, &Controller::view_large_size},
+    {"export_map", MAP_COMMAND, nullptr, nullptr, &Controller::view_export},
+    {"map_mode", MAP_COMMAND, nullptr, nullptr, &Controller::view_mode},
+    {"open_map_view", MAP_COMMAND, nullptr, nullptr, &Controller::open_map_view},
+    {"close_map_view", MAP_COMMAND, nullptr, nullptr, &Controller::close_map_view},
+
+    // sailing commands
+    {"open_sailing_view", SAILING_COMMAND,
+        nullptr, nullptr, &Controller::open_sailing_view},
+    {"close_sailing_view", SAILING_COMMAND,
+        nullptr, nullptr, &Controller::close_sailing_view},
+    {"sailing_top", SAILING_COMMAND, nullptr, nullptr, &Controller::sailing_top},
+    {"sailing_prefix", SAILING_COMMAND,
+        nullptr, nullptr, &Controller::sailing_prefix},
+    {"sailing_all", SAILING_COMMAND, nullptr, nullptr, &Controller::sailing_all},
+
+    // commands needing no args
+    {"open_bridge_view", NO_ARG_COMMAND, &Controller::open_bridge_view, nullptr, nullptr},
+    {"close_bridge_view", NO_ARG_COMMAND, &Controller::close_bridge_view, nullptr, nullptr},
+    {"render_async", NO_ARG_COMMAND, &Controller::render_async, nullptr, nullptr},
+    {"render_sync", NO_ARG_COMMAND, &Controller::render_sync, nullptr, nullptr},
+    {"show", NO_ARG_COMMAND, &Controller::view_show, nullptr, nullptr},
+    {"status", NO_ARG_COMMAND, &Controller::model_status, nullptr, nullptr},
+    {"go", NO_ARG_COMMAND, &Controller::model_go, nullptr, nullptr},
+    {"create", NO_ARG_COMMAND, &Controller::model_create, nullptr, nullptr},
+    {"output", NO_ARG_COMMAND, &Controller::output_mode, nullptr, nullptr},
+    {"save", NO_ARG_COMMAND, &Controller::model_save, nullptr, nullptr},
+    {"restore", NO_ARG_COMMAND, &Controller::model_restore, nullptr, nullptr},
+    {"load", NO_ARG_COMMAND, &Controller::model_load, nullptr, nullptr},
+    {"convert_scenario", NO_ARG_COMMAND,
+        &Controller::convert_scenario, nullptr, nullptr},
+    {"journal", NO_ARG_COMMAND, &Controller::open_journal, nullptr, nullptr},
+    {"close_journal", NO_ARG_COMMAND, &Controller::close_journal, nullptr, nullptr},
+    {"replay", NO_ARG_COMMAND, &Controller::replay_journal, nullptr, nullptr},
+    {"open_trajectory_recorder", NO_ARG_COMMAND,
+        &Controller::open_trajectory_recorder, nullptr, nullptr},
+    {"close_trajectory_recorder", NO_ARG_COMMAND,
+        &Controller::close_trajectory_recorder, nullptr, nullptr},
+    {"open_telemetry_view", NO_ARG_COMMAND,
+        &Controller::open_telemetry_view, nullptr, nullptr},
+    {"close_telemetry_view", NO_ARG_COMMAND,
+        &Controller::close_telemetry_view, nullptr, nullptr}
+};
+
+constexpr int Controller::num_commands =
+    sizeof(command_entries) / sizeof(command_entries[0]);
+
+constexpr bool
+Controller::is_slot_free(int slot, int i)
+{
+    return i == num_commands ||
+           (command_slot(command_entries[i].name) != slot &&
+            is_slot_free(slot, i + 1));
+}
+
+constexpr bool
+Controller::are_slots_unique(int i)
+{
+    return i == num_commands ||
+           (is_slot_free(command_slot(command_entries[i].name), i + 1) &&
+            are_slots_unique(i + 1));
+}
+
+Controller::Controller() :
+    command_table(command_table_size, nullptr),
+    map_ptr(make_shared<Map_View>()),
+    sailing_ptr(make_shared<Sailing_View>()),
+    standard_input(new Command_reader(STDIN_FILENO)),
+    input(standard_input.get())
 {
-    ship_command_map.clear();
-    no_arg_command_map.clear();
-    map_command_map.clear();
-    sailing_command_map.clear();
+    static_assert(are_slots_unique(0),
+                  "Two commands share a slot; choose another command_hash_seed");
+
+    for (int i = 0; i < num_commands; ++i)
+    {
+        command_table[command_slot(command_entries[i].name)] =
+            &command_entries[i];
+    }
 }
 
-// create View object,
-// run the program by acccepting user commands,
-// then destroy View object
+Controller::~Controller()
+{}
+
+// run the program by acccepting user commands
 void
 Controller::run()
 {
-    shared_ptr<View> map_ptr(make_shared<Map_View>());
-    shared_ptr<View> sailing_ptr(make_shared<Sailing_View>());
-    
     // command loop to accept input from users
     while (true)
     {
-        string first_word, second_word;
-        No_Arg_Map_t::const_iterator no_arg_it;
-        Ship_Arg_Map_t::const_iterator ship_arg_it;
-        View_Arg_Map_t::const_iterator view_arg_it;
+        string first_word;
+
+        // the messages of the last command come before the prompt
+        Output::get_Instance().flush();
 
         cout << "\nTime " <<  Model::get_Instance().get_time()
              << ": Enter command: ";
-        
-        cin >> first_word;
+
+        int command_time = Model::get_Instance().get_time();
+        input->begin_command();
+
+        // the input has ended without a quit
+        if (!input->read_word(first_word))
+        {
+            break;
+        }
 
         try
         {
@@ -89,46 +174,25 @@ Controller::run()
             {
                 break;
             }
-            // ship command
-            else if (Model::get_Instance().is_ship_present(first_word))
-            {
-                cin >> second_word;
-                if ((ship_arg_it = ship_command_map.find(second_word)) ==
-                    ship_command_map.end())
-                {
-                    throw Error("Unrecognized command!");
-                }
-                (this->*(ship_arg_it->second))(Model::get_Instance().
-                                                get_ship_ptr(first_word));
-            }
-            // map command
-            else if ((view_arg_it = map_command_map.find(first_word)) !=
-                     map_command_map.end())
-            {
-                (this->*(view_arg_it->second))(map_ptr);
-            }
-            // sailing command
-            else if ((view_arg_it = sailing_command_map.find(first_word)) !=
-                     sailing_command_map.end())
-            {
-                (this->*(view_arg_it->second))(sailing_ptr);
-            }
-            // no arg command
-            else if ((no_arg_it = no_arg_command_map.find(first_word)) !=
-                     no_arg_command_map.end())
-            {
-                (this->*(no_arg_it->second))();
-            }
-            else
+
+            run_command(first_word);
+
+            // opening a journal and replaying one are not journaled;
+            // the commands replayed are; a command that failed
+            // changed nothing
+            if (journal_ptr &&
+                first_word != "journal" &&
+                first_word != "replay")
             {
-                throw Error("Unrecognized command!");
+                journal_ptr->write_command(command_time,
+                                           input->get_command_text());
             }
         }
         catch (Error& error)
         {
+            Output::get_Instance().flush();
             cout << error.msg << endl;
-            cin.clear();
-            while (cin.get() != '\n');
+            input->skip_line();
         }
         catch (bad_alloc& error)
         {
@@ -142,9 +206,78 @@ Controller::run()
         }
     }
 
+    Output::get_Instance().flush();
     cout << "Done" << endl;
 }
 
+// read the rest of a command from input, given its first word,
+// and carry it out
+void
+Controller::run_command(const string& first_word)
+{
+    // a ship's name comes before the command for it
+    int id = Name_table::get_Instance().find(first_word);
+    if (id != -1 && Model::get_Instance().is_ship_present(id))
+    {
+        string second_word;
+        input->read_word(second_word);
+        const Command_entry* entry = find_command(second_word);
+        if (!entry || entry->kind != SHIP_COMMAND)
+        {
+            throw Error("Unrecognized command!");
+        }
+        shared_ptr<Ship> ship_ptr = Model::get_Instance().get_ship_ptr(id);
+
+        // a command can start a dormant ship moving
+        Model::get_Instance().wake(id);
+        (this->*(entry->ship_handler))(ship_ptr);
+        return;
+    }
+
+    const Command_entry* entry = find_command(first_word);
+    if (!entry)
+    {
+        throw Error("Unrecognized command!");
+    }
+
+    // the views cannot be changed while the render thread draws them,
+    // nor can names be added to the Name_table it reads them from
+    if (renderer_ptr &&
+        (entry->kind == MAP_COMMAND ||
+         entry->kind == SAILING_COMMAND ||
+         entry->no_arg_handler == &Controller::open_bridge_view ||
+         entry->no_arg_handler == &Controller::close_bridge_view ||
+         entry->no_arg_handler == &Controller::model_create ||
+         entry->no_arg_handler == &Controller::model_load ||
+         entry->no_arg_handler == &Controller::model_restore))
+    {
+        renderer_ptr->wait_idle();
+    }
+
+    switch (entry->kind)
+    {
+        case NO_ARG_COMMAND:
+            (this->*(entry->no_arg_handler))();
+            break;
+        case MAP_COMMAND:
+            (this->*(entry->view_handler))(map_ptr);
+            break;
+        case SAILING_COMMAND:
+            (this->*(entry->view_handler))(sailing_ptr);
+            break;
+        case SHIP_COMMAND:
+            throw Error("Unrecognized command!");
+    }
+}
+
+// the slot of the name holds the only command the name can be
+const Controller::Command_entry*
+Controller::find_command(const string& name) const
+{
+    const Command_entry* entry = command_table[command_slot(name.c_str())];
+    return (entry && name == entry->name) ? entry : nullptr;
+}
+
 // restore default settings of the map
 void
 Controller::view_default(shared_ptr<View> view_ptr)
@@ -172,7 +305,7 @@ Controller::view_size(shared_ptr<View> view_ptr)
     }
     
     int size;
-    if (!(cin >> size))
+    if (!input->read_int(size))
     {
         throw Error("Expected an integer!");
     }
@@ -192,7 +325,7 @@ Controller::view_zoom(shared_ptr<View> view_ptr)
     }
     
     double scale;
-    if (!(cin >> scale))
+    if (!input->read_double(scale))
     {
         throw Error("Expected a double!");
     }
@@ -211,21 +344,91 @@ Controller::view_pan(shared_ptr<View> view_ptr)
     }
     
     double x, y;
-    if (!(cin >> x) || !(cin >> y))
+    if (!input->read_double(x) || !input->read_double(y))
     {
         throw Error("Expected a double!");
     }
     view_ptr->set_origin(Point(x,y));
 }
 
-// tell View to draw the map
+// read an integer for a size beyond that of the size command
+void
+Controller::view_large_size(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Map view is not open!");
+    }
+
+    int size;
+    if (!input->read_int(size))
+    {
+        throw Error("Expected an integer!");
+    }
+    view_ptr->set_large_size(size);
+}
+
+// read a file name, and optionally the number of pixels on a side,
+// and write an image of where the objects are
+void
+Controller::view_export(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Map view is not open!");
+    }
+
+    string file_name;
+    input->read_word(file_name);
+
+    int pixels = 512;
+    if (isdigit(input->peek_on_line()) && !input->read_int(pixels))
+    {
+        throw Error("Expected an integer!");
+    }
+    view_ptr->export_image(file_name, pixels);
+}
+
+// read whether the map is drawn whole or only as the cells that changed
+void
+Controller::view_mode(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Map view is not open!");
+    }
+
+    string mode;
+    input->read_word(mode);
+    if (mode != "diff" && mode != "full")
+    {
+        throw Error("Expected diff or full!");
+    }
+
+    view_ptr->set_diff_mode(mode == "diff");
+}
+
+// tell View to draw the map, or have the render thread do so
 void
 Controller::view_show()
 {
+    if (renderer_ptr)
+    {
+        publish_frame();
+        return;
+    }
+
     for_each(view_container.begin(),
              view_container.end(),
              [](shared_ptr<View> view_ptr)
              {view_ptr->draw();});
+    Model::get_Instance().clear_world_moves();
 }
 
 // have all objects describe themselves
@@ -239,7 +442,255 @@ Controller::model_status()
 void
 Controller::model_go()
 {
-    Model::get_Instance().update();
+    // a plain go is a single update
+    if (input->peek_on_line() == EOF)
+    {
+        Model::get_Instance().update();
+        publish_frame();
+        return;
+    }
+
+    // go N makes N updates silently, fast-forwarding through the quiet
+    // ones, unless "all" asks for the output of every one
+    int num_updates;
+    if (!input->read_int(num_updates) || num_updates <= 0)
+    {
+        throw Error("Expected a positive integer!");
+    }
+
+    bool show_all = false;
+    if (isalpha(input->peek_on_line()))
+    {
+        string word;
+        input->read_word(word);
+        if (word != "all")
+        {
+            throw Error("Unrecognized command!");
+        }
+        show_all = true;
+    }
+
+    if (show_all)
+    {
+        for (int i = 0; i < num_updates; ++i)
+        {
+            Model::get_Instance().update();
+            publish_frame();
+        }
+        return;
+    }
+
+    // the messages of the updates in which something happens
+    // go to a sink that is then discarded
+    Output& output = Output::get_Instance();
+    shared_ptr<Output_sink> sink_ptr = output.get_sink();
+    output.set_sink(make_shared<Quiet_output_sink>());
+    try
+    {
+        Model::get_Instance().fast_forward(num_updates);
+    }
+    catch (...)
+    {
+        output.set_sink(sink_ptr);
+        throw;
+    }
+    output.set_sink(sink_ptr);
+    publish_frame();
+}
+
+// read a file name and save a checkpoint of the Model to it
+void
+Controller::model_save()
+{
+    string file_name;
+    input->read_word(file_name);
+    Model::get_Instance().save(file_name);
+}
+
+// read a file name and restore the Model from the checkpoint in it
+void
+Controller::model_restore()
+{
+    string file_name;
+    input->read_word(file_name);
+    Model::get_Instance().restore(file_name);
+}
+
+// read a scenario file name, and replace every object
+// with those of the scenario
+void
+Controller::model_load()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    Scenario scenario;
+    scenario.read(file_name);
+    Model::get_Instance().load(scenario);
+}
+
+// read the names of a scenario file and of a file to write
+// the same scenario to in the binary form
+void
+Controller::convert_scenario()
+{
+    string file_name, binary_file_name;
+    input->read_word(file_name);
+    input->read_word(binary_file_name);
+
+    Scenario scenario;
+    scenario.read(file_name);
+    scenario.write_binary(binary_file_name);
+}
+
+// read a file name and journal the commands accepted from now on to it
+void
+Controller::open_journal()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    if (journal_ptr)
+    {
+        throw Error("Journal is already open!");
+    }
+
+    journal_ptr.reset(new Command_journal(file_name));
+}
+
+void
+Controller::close_journal()
+{
+    if (!journal_ptr)
+    {
+        throw Error("Journal is not open!");
+    }
+
+    journal_ptr.reset();
+}
+
+// read a journal file name, and optionally a time to stop at,
+// and run the commands in the journal without prompts;
+// commands from before the current time are skipped, so a journal
+// can be replayed from a restored checkpoint,
+// and the replay stops at the first command that fails
+void
+Controller::replay_journal()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    int stop_time = -1;
+    if (isdigit(input->peek_on_line()) && !input->read_int(stop_time))
+    {
+        throw Error("Expected an integer!");
+    }
+
+    ifstream file(file_name.c_str());
+    if (!file)
+    {
+        throw Error("Could not open journal file!");
+    }
+
+    Command_reader* saved_input = input;
+    string line;
+    int line_number = 0;
+
+    while (getline(file, line))
+    {
+        ++line_number;
+        Command_reader line_reader(line);
+        int command_time;
+        string first_word;
+
+        try
+        {
+            if (!line_reader.read_int(command_time))
+            {
+                throw Error("Journal file is damaged!");
+            }
+            line_reader.begin_command();
+            if (!line_reader.read_word(first_word))
+            {
+                throw Error("Journal file is damaged!");
+            }
+
+            int time = Model::get_Instance().get_time();
+            if (stop_time >= 0 && command_time >= stop_time)
+            {
+                break;
+            }
+            if (command_time < time)
+            {
+                continue;
+            }
+            if (command_time > time)
+            {
+                throw Error("Journal does not match the time!");
+            }
+
+            // messages of earlier commands come before any direct output
+            Output::get_Instance().flush();
+            input = &line_reader;
+            run_command(first_word);
+            input = saved_input;
+        }
+        catch (Error& error)
+        {
+            input = saved_input;
+            Output::get_Instance().flush();
+            cout << "Replay stopped at line " << line_number << ": "
+                 << error.msg << endl;
+            return;
+        }
+
+        if (journal_ptr)
+        {
+            journal_ptr->write_command(command_time,
+                                       line_reader.get_command_text());
+        }
+    }
+}
+
+// read the mode of output for the messages of the objects:
+// "text", "quiet", or "binary" and a file name;
+// on leaving quiet mode, say how many messages were not shown
+void
+Controller::output_mode()
+{
+    string mode;
+    input->read_word(mode);
+
+    shared_ptr<Output_sink> sink_ptr;
+    if (mode == "text")
+    {
+        sink_ptr = make_shared<Text_output_sink>();
+    }
+    else if (mode == "quiet")
+    {
+        sink_ptr = make_shared<Quiet_output_sink>();
+    }
+    else if (mode == "binary")
+    {
+        string file_name;
+        input->read_word(file_name);
+        sink_ptr = make_shared<Binary_output_sink>(file_name);
+    }
+    else
+    {
+        throw Error("Unrecognized output mode!");
+    }
+
+    shared_ptr<Quiet_output_sink> quiet_ptr =
+        dynamic_pointer_cast<Quiet_output_sink>(Output::get_Instance().
+                                                    get_sink());
+    Output::get_Instance().set_sink(sink_ptr);
+
+    if (quiet_ptr)
+    {
+        cout << quiet_ptr->get_total_count()
+             << " messages were not shown" << endl;
+    }
 }
 
 // read name for a new ship
@@ -255,7 +706,7 @@ Controller::model_create()
     double x, y;
     string name, type;
 
-    cin >> name;
+    input->read_word(name);
     if (name.length() < 2)
     {
         throw Error("Name is too short!");
@@ -265,8 +716,8 @@ Controller::model_create()
         throw Error("Name is already in use!");
     }
 
-    cin >> type;
-    if (!(cin >> x) || !(cin >> y))
+    input->read_word(type);
+    if (!input->read_double(x) || !input->read_double(y))
     {
         throw Error("Expected a double!");
     }
@@ -281,7 +732,7 @@ Controller::ship_course(shared_ptr<Ship>ship_ptr)
     double heading, speed;
 
     // error check heading
-    if (!(cin >> heading))
+    if (!input->read_double(heading))
     {
         throw Error("Expected a double!");
     }
@@ -300,7 +751,7 @@ Controller::ship_position(shared_ptr<Ship>ship_ptr)
 {
     double x, y, speed;
 
-    if (!(cin >> x) || !(cin >> y))
+    if (!input->read_double(x) || !input->read_double(y))
     {
         throw Error("Expected a double!");
     }
@@ -388,6 +839,9 @@ void
 Controller::close_map_view(std::shared_ptr<View> view_ptr)
 {
     close_view(view_ptr, "Map view is not open!");
+
+    // a map opened again starts out drawn whole
+    view_ptr->set_diff_mode(false);
 }
 
 void
@@ -402,11 +856,75 @@ Controller::close_sailing_view(std::shared_ptr<View> view_ptr)
     close_view(view_ptr, "Sailing data view is not open!");
 }
 
+// read the number of ships and whether they are those
+// with the least fuel or the highest speed
+void
+Controller::sailing_top(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Sailing data view is not open!");
+    }
+
+    int count;
+    if (!input->read_int(count))
+    {
+        throw Error("Expected an integer!");
+    }
+
+    string ranking;
+    input->read_word(ranking);
+    if (ranking == "fuel")
+    {
+        view_ptr->set_lowest_fuel(count);
+    }
+    else if (ranking == "speed")
+    {
+        view_ptr->set_highest_speed(count);
+    }
+    else
+    {
+        throw Error("Expected fuel or speed!");
+    }
+}
+
+// read the start of the names of the ships to be shown
+void
+Controller::sailing_prefix(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Sailing data view is not open!");
+    }
+
+    string prefix;
+    input->read_word(prefix);
+    view_ptr->set_name_prefix(prefix);
+}
+
+// show all of the ships again
+void
+Controller::sailing_all(shared_ptr<View> view_ptr)
+{
+    if (find(view_container.begin(),
+             view_container.end(),
+             view_ptr) == view_container.end())
+    {
+        throw Error("Sailing data view is not open!");
+    }
+
+    view_ptr->set_defaults();
+}
+
 void
 Controller::open_bridge_view()
 {
     string name;
-    cin >> name;
+    input->read_word(name);
     
     auto it = bridge_map.find(name);
     
@@ -422,12 +940,8 @@ Controller::open_bridge_view()
     
     shared_ptr<Ship> ship_ptr = Model::get_Instance().get_ship_ptr(name);
     
-    shared_ptr<View> view_ptr(make_shared<Bridge_View>(ship_ptr->get_name(),
-                                                       ship_ptr->get_location(),
-                                                       ship_ptr->get_heading(),
-                                                       !ship_ptr->is_afloat()));
+    shared_ptr<View> view_ptr(make_shared<Bridge_View>(ship_ptr->get_id()));
     
-    Model::get_Instance().attach(view_ptr);
     bridge_map[name] = view_ptr;
     view_container.push_back(view_ptr);
 }
@@ -436,7 +950,7 @@ void
 Controller::close_bridge_view()
 {
     string name;
-    cin >> name;
+    input->read_word(name);
     
     auto it = bridge_map.find(name);
     
@@ -445,18 +959,119 @@ Controller::close_bridge_view()
         throw Error("Bridge view for that ship is not open!");
     }
     
-    Model::get_Instance().detach(it->second);
-    bridge_map.erase(it);
     view_container.erase(find(view_container.begin(),
                               view_container.end(),
                               it->second));
+    bridge_map.erase(it);
+}
+
+// read a file name and start recording the trajectories to it;
+// the recorder is not drawn, so it is not kept with the other views
+void
+Controller::open_trajectory_recorder()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    if (recorder_ptr)
+    {
+        throw Error("Trajectory recorder is already open!");
+    }
+
+    recorder_ptr = make_shared<Trajectory_recorder>(file_name);
+    Model::get_Instance().attach(recorder_ptr);
+}
+
+// stop recording, which completes the file
+void
+Controller::close_trajectory_recorder()
+{
+    if (!recorder_ptr)
+    {
+        throw Error("Trajectory recorder is not open!");
+    }
+
+    Model::get_Instance().detach(recorder_ptr);
+    recorder_ptr.reset();
+}
+
+// read a file name and start streaming the changes to it;
+// like the recorder, the view is told of every change but not drawn
+void
+Controller::open_telemetry_view()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    if (telemetry_ptr)
+    {
+        throw Error("Telemetry view is already open!");
+    }
+
+    telemetry_ptr = make_shared<Telemetry_view>(file_name);
+    Model::get_Instance().attach(telemetry_ptr);
+}
+
+// stop streaming, once the records already made are written
+void
+Controller::close_telemetry_view()
+{
+    if (!telemetry_ptr)
+    {
+        throw Error("Telemetry view is not open!");
+    }
+
+    Model::get_Instance().detach(telemetry_ptr);
+    telemetry_ptr.reset();
+}
+
+// read a file name and start drawing the views to it
+// on a thread of their own
+void
+Controller::render_async()
+{
+    string file_name;
+    input->read_word(file_name);
+
+    if (renderer_ptr)
+    {
+        throw Error("Render thread is already running!");
+    }
+
+    renderer_ptr.reset(new Renderer(file_name));
+}
+
+// draw what is waiting, and draw the views here again
+void
+Controller::render_sync()
+{
+    if (!renderer_ptr)
+    {
+        throw Error("Render thread is not running!");
+    }
+
+    renderer_ptr.reset();
+}
+
+// in async mode, each tick and each show is a frame for the render thread
+void
+Controller::publish_frame()
+{
+    if (!renderer_ptr)
+    {
+        return;
+    }
+
+    Model& model = Model::get_Instance();
+    renderer_ptr->publish(view_container, model.get_world(), model.get_time());
+    model.clear_world_moves();
 }
 
 double
 Controller::receive_and_check_speed()
 {
     double speed;
-    if (!(cin >> speed))
+    if (!input->read_double(speed))
     {
         throw Error("Expected a double!");
     }
@@ -471,7 +1086,7 @@ string
 Controller::receive_and_check_island()
 {
     string name;
-    cin >> name;
+    input->read_word(name);
     if (!Model::get_Instance().is_island_present(name))
     {
         throw Error("Island not found!");
@@ -483,7 +1098,7 @@ string
 Controller::receive_and_check_ship()
 {
     string name;
-    cin >> name;
+    input->read_word(name);
     if (!Model::get_Instance().is_ship_present(name))
     {
         throw Error("Ship not found!");
@@ -503,7 +1118,6 @@ Controller::open_view(shared_ptr<View> view_ptr, const string& error)
         throw Error(error.c_str());
     }
     
-    Model::get_Instance().attach(view_ptr);
     view_container.push_back(view_ptr);
 }
 
@@ -519,6 +1133,5 @@ Controller::close_view(shared_ptr<View> view_ptr, const string& error)
         throw Error(error.c_str());
     }
     
-    Model::get_Instance().detach(view_ptr);
     view_container.erase(it);
 }
@@ -13,32 +13,47 @@
 #include <vector>
 
 class View;
+class Renderer;
 class Ship;
+class Command_journal;
+class Command_reader;
 
 class Controller
 {
   public:       
-      // constructor
+      // constructor creates the map and sailing View objects
       Controller();
 
       // destructor
       ~Controller();
 
-      // create View object,
-      // run the program by acccepting user commands,
-      // then destroy View object
+      // run the program by acccepting user commands
       void run();
 
   private:
+      // read the rest of a command and carry it out
+      void run_command(const std::string& first_word);
+
       // command functions
       void view_default(std::shared_ptr<View>);
       void view_size(std::shared_ptr<View>);
       void view_zoom(std::shared_ptr<View>);
       void view_pan(std::shared_ptr<View>);
+      void view_large_size(std::shared_ptr<View>);
+      void view_export(std::shared_ptr<View>);
+      void view_mode(std::shared_ptr<View>);
       void view_show();
       void model_status();
       void model_go();
       void model_create();
+      void output_mode();
+      void model_save();
+      void model_restore();
+      void model_load();
+      void convert_scenario();
+      void open_journal();
+      void close_journal();
+      void replay_journal();
       void ship_course(std::shared_ptr<Ship>);
       void ship_position(std::shared_ptr<Ship>);
       void ship_destination(std::shared_ptr<Ship>);
@@ -53,8 +68,20 @@ class Controller
       void close_map_view(std::shared_ptr<View>);
       void open_sailing_view(std::shared_ptr<View>);
       void close_sailing_view(std::shared_ptr<View>);
+      void sailing_top(std::shared_ptr<View>);
+      void sailing_prefix(std::shared_ptr<View>);
+      void sailing_all(std::shared_ptr<View>);
       void open_bridge_view();
       void close_bridge_view();
+      void render_async();
+      void render_sync();
+      void open_trajectory_recorder();
+      void close_trajectory_recorder();
+      void open_telemetry_view();
+      void close_telemetry_view();
+
+      // hand the views to the render thread, if it is running
+      void publish_frame();
 
       // error check functions and helpers
       double receive_and_check_speed();
@@ -63,18 +90,69 @@ class Controller
       void open_view(std::shared_ptr<View>, const std::string &);
       void close_view(std::shared_ptr<View>, const std::string &);
     
-      // maps for ship, model, view commands
-      std::map<std::string, void (Controller::*)(std::shared_ptr<Ship>)>
-          ship_command_map;
-      std::map<std::string, void (Controller::*)(std::shared_ptr<View>)>
-          map_command_map;
-      std::map<std::string, void (Controller::*)(std::shared_ptr<View>)>
-          sailing_command_map;
-      std::map<std::string, void (Controller::*)()> no_arg_command_map;
+      // what a command's handler is called with
+      enum Command_kind_e
+      {
+          NO_ARG_COMMAND,
+          SHIP_COMMAND,
+          MAP_COMMAND,
+          SAILING_COMMAND
+      };
+
+      // a command word and its handler; only the handler
+      // for the kind of command is set
+      struct Command_entry
+      {
+          const char* name;
+          Command_kind_e kind;
+          void (Controller::*no_arg_handler)();
+          void (Controller::*ship_handler)(std::shared_ptr<Ship>);
+          void (Controller::*view_handler)(std::shared_ptr<View>);
+      };
+
+      // every command; the hash of the names is checked when compiling
+      static const Command_entry command_entries[];
+      static const int num_commands;
+
+      // does no command after the first i have the slot?
+      static constexpr bool is_slot_free(int slot, int i);
+
+      // does each command from i on have a slot of its own?
+      static constexpr bool are_slots_unique(int i);
+
+      // the commands, indexed by the hash of their names,
+      // with nullptr for a slot no command has
+      std::vector<const Command_entry*> command_table;
+
+      // return the command with the name, or nullptr if none
+      const Command_entry* find_command(const std::string&) const;
     
       // map of views for ordering and to map bridge views
       std::vector<std::shared_ptr<View>> view_container;
       std::map<std::string, std::shared_ptr<View>> bridge_map;
+
+      // records the trajectories to a file while it is open
+      std::shared_ptr<View> recorder_ptr;
+
+      // streams the changes to a file or pipe while it is open
+      std::shared_ptr<View> telemetry_ptr;
+
+      // draws the views on a thread of its own while it is running
+      std::unique_ptr<Renderer> renderer_ptr;
+
+      // the views that map and sailing commands apply to
+      std::shared_ptr<View> map_ptr;
+      std::shared_ptr<View> sailing_ptr;
+
+      // reads the commands typed or piped in
+      std::unique_ptr<Command_reader> standard_input;
+
+      // where commands are read from: the standard input,
+      // or a line of a journal being replayed
+      Command_reader* input;
+
+      // journals the commands while it is open
+      std::unique_ptr<Command_journal> journal_ptr;
 };
 
 #endif
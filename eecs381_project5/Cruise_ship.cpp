@@ -1,12 +1,17 @@
 #include "Cruise_ship.h"
 #include "Model.h"
 #include "Island.h"
+#include "Output.h"
+#include "Checkpoint.h"
 #include "Utility.h"
 #include <algorithm>
 #include <cfloat>
 
 using namespace std;
 
+// radius of the first search for the next island to visit, in nm
+const double island_search_radius = 20.;
+
 Cruise_ship::Cruise_ship(const string& name_, Point position_) :
     Ship(name_, position_, 500., 15., 2., 0),
     cruise_speed(0.),
@@ -48,21 +53,23 @@ Cruise_ship::update()
                 next_island =
                     Model::get_Instance().is_location_island(destination);
                 cruise_ship_state = CRUISING;
-                cout << get_name() << " will visit "
-                     << next_island->get_name() << endl;
+                Output::get_Instance().write(Output_sink::CRUISE_WILL_VISIT,
+                                             get_id(),
+                                             next_island->get_id());
                 break;
         }
     }
-    else if (!is_moving() && can_dock(next_island) &&
-             cruise_ship_state == CRUISING)
+    else if (cruise_ship_state == CRUISING && !is_moving() &&
+             can_dock(next_island))
     {
         dock(next_island);
 
-        if (Model::get_Instance().get_island_locations().size() ==
-            visited_islands.size())
+        if (Model::get_Instance().get_island_count() ==
+            static_cast<int>(visited_islands.size()))
         {
-            cout << get_name() << " cruise is over at "
-                 << first_island->get_name() << endl;
+            Output::get_Instance().write(Output_sink::CRUISE_OVER_AT,
+                                         get_id(),
+                                         first_island->get_id());
             cruise_ship_state = NOT_CRUISING;
         }
         else
@@ -73,6 +80,67 @@ Cruise_ship::update()
     }
 }
 
+bool
+Cruise_ship::is_dormant() const
+{
+    return (cruise_ship_state == NOT_CRUISING && Ship::is_dormant());
+}
+
+int
+Cruise_ship::get_quiet_updates() const
+{
+    switch (cruise_ship_state)
+    {
+        case NOT_CRUISING:
+            return Ship::get_quiet_updates();
+        case CRUISING:
+            return (is_moving() ? Ship::get_quiet_updates() : 0);
+        default:
+            return 0;
+    }
+}
+
+void
+Cruise_ship::save_state(Checkpoint_writer& writer) const
+{
+    Ship::save_state(writer);
+    writer.write_double(cruise_speed);
+    writer.write_int(cruise_ship_state);
+    writer.write_island(first_island);
+    writer.write_island(next_island);
+    writer.write_int(static_cast<int32_t>(visited_islands.size()));
+    for_each(visited_islands.begin(),
+             visited_islands.end(),
+             [&writer](Point location){writer.write_point(location);});
+}
+
+void
+Cruise_ship::restore_state(Checkpoint_reader& reader)
+{
+    Ship::restore_state(reader);
+    cruise_speed = reader.read_double();
+
+    int32_t state = reader.read_int();
+    if (state < NOT_CRUISING || state > THIRD_UPDATE)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    cruise_ship_state = static_cast<Cruise_Ship_State_e>(state);
+    first_island      = reader.read_island();
+    next_island       = reader.read_island();
+
+    int32_t num_visited = reader.read_int();
+    if (num_visited < 0)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    visited_islands.clear();
+    for (int32_t i = 0; i < num_visited; ++i)
+    {
+        visited_islands.push_back(reader.read_point());
+    }
+}
+
 void
 Cruise_ship::describe() const
 {
@@ -108,10 +176,12 @@ Cruise_ship::set_destination_position_and_speed(Point destination, double speed)
         first_island      = island_ptr;
         next_island       = island_ptr;
         cruise_ship_state = CRUISING;
-        cout << get_name() << " will visit "
-            << island_ptr->get_name() << endl;
-        cout << get_name() << " cruise will start and end at "
-             << island_ptr->get_name() << endl;
+        Output::get_Instance().write(Output_sink::CRUISE_WILL_VISIT,
+                                     get_id(),
+                                     island_ptr->get_id());
+        Output::get_Instance().write(Output_sink::CRUISE_WILL_START_AT,
+                                     get_id(),
+                                     island_ptr->get_id());
     }
 }
 
@@ -139,60 +209,61 @@ Cruise_ship::stop_cruise()
         next_island       = nullptr;
         cruise_ship_state = NOT_CRUISING;
         visited_islands.clear();
-        cout << get_name() << " canceling current cruise" << endl;
+        Output::get_Instance().write(Output_sink::CRUISE_CANCELING, get_id());
     }
 }
 
 Point
 Cruise_ship::get_next_island_location()
 {
-    double min_distance = DBL_MAX;
+    Model& model = Model::get_Instance();
     Point next_destination;
     
-    vector<Point> island_locations = Model::get_Instance().
-                                         get_island_locations();
-    
-    if (island_locations.size() == visited_islands.size())
+    if (model.get_island_count() == static_cast<int>(visited_islands.size()))
     {
         next_destination = first_island->get_location();
         return next_destination;
     }
     
-    // obtain shortest distance location out of the unvisited islands
-    for_each(island_locations.begin(),
-             island_locations.end(),
-             [this, &min_distance, &next_destination]
-             (Point location)
-             {
-                 double distance;
-                 auto it = find(visited_islands.begin(),
-                                visited_islands.end(),
-                                location);
-                 
-                 // the island has not been visited yet
-                 if (it == visited_islands.end())
+    // search ever larger circles around the current island
+    // until one holds an unvisited island; the closest unvisited island
+    // in that circle is then the closest of them all
+    Point current_location = next_island->get_location();
+    for (double radius = island_search_radius; ; radius *= 2.)
+    {
+        double min_distance = DBL_MAX;
+        vector<shared_ptr<Island>> islands =
+            model.get_islands_within(current_location, radius);
+        
+        // obtain shortest distance location out of the unvisited islands
+        for_each(islands.begin(),
+                 islands.end(),
+                 [this, &current_location, &min_distance, &next_destination]
+                 (shared_ptr<Island> island_ptr)
                  {
-                     distance = cartesian_distance(next_island->get_location(),
-                                                   location);
+                     Point location = island_ptr->get_location();
+                     auto it = find(visited_islands.begin(),
+                                    visited_islands.end(),
+                                    location);
                      
-                     if (distance < min_distance)
+                     // the island has not been visited yet
+                     if (it == visited_islands.end())
                      {
-                         min_distance = distance;
-                         next_destination = location;
+                         double distance = cartesian_distance(current_location,
+                                                              location);
+                         
+                         if (distance < min_distance)
+                         {
+                             min_distance = distance;
+                             next_destination = location;
+                         }
                      }
-                 }
-             });
-    
-    return next_destination;
+                 });
+        
+        if (min_distance < DBL_MAX ||
+            static_cast<int>(islands.size()) == model.get_island_count())
+        {
+            return next_destination;
+        }
+    }
 }
-
-
-
-
-
-
-
-
-
-
-
@@ -22,6 +22,18 @@ class Cruise_ship : public Ship
     
       // output a description of current state to cout
       void describe() const override;
+
+      // a Cruise_ship on a cruise is never dormant,
+      // and is quiet only while sailing to the next island
+      bool is_dormant() const override;
+      int get_quiet_updates() const override;
+
+      const char* get_type_name() const override
+          {return "Cruise_ship";}
+
+      // the cruise: its speed, state, and islands
+      void save_state(Checkpoint_writer&) const override;
+      void restore_state(Checkpoint_reader&) override;
     
       // Start moving to a destination position at a speed
       // cancels any cruises if destination isn't an island
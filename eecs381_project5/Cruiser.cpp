@@ -1,4 +1,5 @@
 #include "Cruiser.h"
+#include "Output.h"
 
 using namespace std;
 
@@ -11,9 +12,9 @@ Cruiser::~Cruiser()
 {}
 
 void
-Cruiser::update()
+Cruiser::attack_target()
 {
-    Warship::update();
+    Warship::attack_target();
 
     if (is_attacking())
     {
@@ -23,8 +24,8 @@ Cruiser::update()
         }
         else
         {
-            cout << get_name()
-                 << " target is out of range" << endl;
+            Output::get_Instance().write(Output_sink::WARSHIP_OUT_OF_RANGE,
+                                         get_id());
             stop_attack();
         }
     }
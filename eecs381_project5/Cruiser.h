@@ -30,9 +30,16 @@ class Cruiser : public Warship
     // destructor
     ~Cruiser();
 
-    void update() override;
     void describe() const override;
     void receive_hit(int, std::shared_ptr<Ship>) override;
+
+    const char* get_type_name() const override
+        {return "Cruiser";}
+
+  protected:
+    // after the Warship part, fire at the target if it is in range,
+    // or stop attacking
+    void attack_target() override;
 };
 
 #endif
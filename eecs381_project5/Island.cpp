@@ -1,5 +1,8 @@
 #include "Island.h"
 #include "Model.h"
+#include "Output.h"
+#include "Checkpoint.h"
+#include "Tick_intents.h"
 
 using std::cout;
 using std::string;
@@ -33,8 +36,7 @@ Island::provide_fuel(double request)
         fuel -= request;
     }
 
-    cout << "Island " << get_name() << " supplied "
-         << request << " tons of fuel" << endl;
+    Output::get_Instance().write(Output_sink::ISLAND_SUPPLIED, get_id(), request);
 
     return request;
 }
@@ -43,8 +45,7 @@ void
 Island::accept_fuel(double amount)
 {
     fuel += amount;
-    cout << "Island " << get_name()  << " now has "
-         << fuel  << " tons" << endl;
+    Output::get_Instance().write(Output_sink::ISLAND_NOW_HAS, get_id(), fuel);
 }
 
 void
@@ -52,12 +53,41 @@ Island::update()
 {
     if (production_rate > 0)
     {
-        fuel += production_rate * 1.0;
-        cout << "Island " << get_name()  << " now has "
-             << fuel  << " tons" << endl;
+        Tick_intents::carry_out(Tick_intents::FUEL_TRANSFER,
+                                [this]{produce_fuel();});
     }
 }
 
+void
+Island::produce_fuel()
+{
+    fuel += production_rate * 1.0;
+    Output::get_Instance().write(Output_sink::ISLAND_NOW_HAS, get_id(), fuel);
+}
+
+void
+Island::skip_updates(int num_updates)
+{
+    if (production_rate > 0)
+    {
+        fuel += production_rate * num_updates;
+    }
+}
+
+void
+Island::save_state(Checkpoint_writer& writer) const
+{
+    writer.write_double(fuel);
+    writer.write_double(production_rate);
+}
+
+void
+Island::restore_state(Checkpoint_reader& reader)
+{
+    fuel            = reader.read_double();
+    production_rate = reader.read_double();
+}
+
 void
 Island::describe() const
 {
@@ -70,5 +100,5 @@ Island::describe() const
 void
 Island::broadcast_current_state()
 {
-    Model::get_Instance().notify_location(get_name(), position);
+    Model::get_Instance().notify_location(get_id(), position);
 }
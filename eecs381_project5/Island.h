@@ -10,6 +10,7 @@
 ********************************************************************/
 
 #include "Sim_object.h"
+#include <limits>
 
 class Island : public Sim_object
 {
@@ -42,9 +43,23 @@ class Island : public Sim_object
           {return position;}
 
       // if production_rate > 0, compute production_rate * unit time,
-      // and add to amount, and print an update message
+      // and add to amount, and print an update message;
+      // the fuel is added as a FUEL_TRANSFER step
       void update() override;
 
+      // an Island that produces nothing has nothing to update
+      bool is_dormant() const override
+          {return production_rate <= 0;}
+
+      // production goes on at the same rate forever
+      int get_quiet_updates() const override
+          {return std::numeric_limits<int>::max();}
+      void skip_updates(int) override;
+
+      // the fuel and production rate
+      void save_state(Checkpoint_writer&) const override;
+      void restore_state(Checkpoint_reader&) override;
+
       // output information about the current state
       void describe() const override;
 
@@ -55,6 +70,9 @@ class Island : public Sim_object
       Point position;
       double fuel;
       double production_rate;
+
+      // add a unit time of production to the amount
+      void produce_fuel();
 };
 
 #endif
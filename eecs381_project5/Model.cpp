@@ -4,12 +4,67 @@
 #include "Views.h"
 #include "Sim_object.h"
 #include "Ship_factory.h"
+#include "Checkpoint.h"
+#include "Scenario.h"
+#include "Tick_intents.h"
+#include "Worker_pool.h"
 #include "Utility.h"
 #include <algorithm>
-#include <list>
 
 using namespace std;
 
+// side of a cell of the island location index, in nm
+const double island_cell_size = 10.;
+
+// number of distinct pairs of characters that can begin a name
+const int num_name_prefixes = 65536;
+
+// the islands and ships the Model starts with
+const char* const initial_scenario =
+    "island Exxon 10 10 1000 200\n"
+    "island Shell 0 30 1000 200\n"
+    "island Bermuda 20 20\n"
+    "island Treasure_Island 50 5 100 5\n"
+    "ship Ajax Cruiser 15 15\n"
+    "ship Xerxes Cruiser 25 25\n"
+    "ship Valdez Tanker 30 30\n";
+
+// index of the first two characters of the name into Model::prefix_counts
+inline int name_prefix(const string& name)
+{
+    return (static_cast<unsigned char>(name[0]) << 8) |
+            static_cast<unsigned char>(name[1]);
+}
+
+// create the islands and ships of a scenario, in the order listed
+inline void create_objects(const Scenario& scenario,
+                           vector<shared_ptr<Island>>& new_islands,
+                           vector<shared_ptr<Ship>>& new_ships)
+{
+    const vector<Scenario::Island_entry>& islands = scenario.get_islands();
+    new_islands.reserve(islands.size());
+    for_each(islands.begin(),
+             islands.end(),
+             [&new_islands](const Scenario::Island_entry& island)
+             {
+                 new_islands.push_back(make_shared<Island>(island.name,
+                                                           island.location,
+                                                           island.fuel,
+                                                           island.production_rate));
+             });
+
+    const vector<Scenario::Ship_entry>& ships = scenario.get_ships();
+    new_ships.reserve(ships.size());
+    for_each(ships.begin(),
+             ships.end(),
+             [&new_ships](const Scenario::Ship_entry& ship)
+             {
+                 new_ships.push_back(create_ship(ship.name,
+                                                 ship.type,
+                                                 ship.location));
+             });
+}
+
 Model&
 Model::get_Instance()
 {
@@ -18,87 +73,93 @@ Model::get_Instance()
 }
 
 Model::Model() :
-    time(0)
+    time(0),
+    island_index(island_cell_size),
+    prefix_counts(num_name_prefixes, 0),
+    world_filled(false),
+    collecting_changes(nullptr)
 {
+    dormant_walk = dormant_ship_ids.end();
+
     // create initial set of islands and ships
     // and place them into the appropriate containers
-    shared_ptr<Island>
-        exxon(make_shared<Island>("Exxon",Point(10,10),1000,200)),
-        shell(make_shared<Island>("Shell",Point(0,30),1000,200)),
-        bermuda(make_shared<Island>("Bermuda",Point(20,20))),
-        island(make_shared<Island>("Treasure_Island",Point(50,5),100,5));
-    
-    sim_object_map["Exxon"]           = island_map["Exxon"]   = exxon;
-    sim_object_map["Shell"]           = island_map["Shell"]   = shell;
-    sim_object_map["Bermuda"]         = island_map["Bermuda"] = bermuda;
-    sim_object_map["Treasure_Island"] = island_map["Treasure_Island"] = island;
-    
-    sim_object_map["Ajax"]    =
-    ship_map["Ajax"]          = create_ship("Ajax","Cruiser",Point(15,15));
-    sim_object_map["Xerxes"]  =
-    ship_map["Xerxes"]        = create_ship("Xerxes","Cruiser",Point(25,25));
-    sim_object_map["Valdez"]  =
-    ship_map["Valdez"]        = create_ship("Valdez","Tanker",Point(30,30));
+    Scenario scenario;
+    scenario.parse_text(initial_scenario);
+
+    vector<shared_ptr<Island>> new_islands;
+    vector<shared_ptr<Ship>> new_ships;
+    create_objects(scenario, new_islands, new_ships);
+    insert_objects(new_islands, new_ships);
 }
 
 Model::~Model()
 {
-
-    // clear the maps
-    island_map.clear();
-    ship_map.clear();
-    sim_object_map.clear();
+    // clear the containers
+    sim_object_ids.clear();
+    island_ids.clear();
+    active_ids.clear();
+    dormant_ship_ids.clear();
+    islands.clear();
+    ships.clear();
+    sim_objects.clear();
 }
 
 bool
 Model::is_name_in_use(const string& name) const
 {
-    // identical name in map
-    if (sim_object_map.find(name) != sim_object_map.end())
-    {
-        return true;
-    }
-
-    // identical in first two characters
-    return any_of(sim_object_map.begin(),
-                  sim_object_map.end(),
-                  [&name](pair<string, shared_ptr<Sim_object>> obj)
-                  {return (obj.first[0] == name[0] &&
-                           obj.first[1] == name[1]);});
+    // an identical name is also identical in the first two characters,
+    // so only the count of objects with that prefix is needed
+    return (prefix_counts[name_prefix(name)] > 0);
 }
 
 bool
 Model::is_island_present(const string& name) const
 {
-    return (island_map.find(name) != island_map.end());
+    int id = find_id(name);
+    return (id != -1 && islands[id]);
 }
 
 void
 Model::add_island(shared_ptr<Island> island_ptr)
 {
-    sim_object_map[island_ptr->get_name()] =
-    island_map[island_ptr->get_name()]     = island_ptr;
+    insert_island(island_ptr);
     island_ptr->broadcast_current_state();
 }
 
 shared_ptr<Island>
 Model::get_island_ptr(const string& name) const
 {
-    map<string, shared_ptr<Island>>::const_iterator it = island_map.find(name);
-    if (it == island_map.end())
+    int id = find_id(name);
+    if (id == -1 || !islands[id])
+    {
+        throw Error("Island not found!");
+    }
+    return islands[id];
+}
+
+shared_ptr<Island>
+Model::get_island_ptr(int id) const
+{
+    if (id < 0 || id >= static_cast<int>(islands.size()) || !islands[id])
     {
         throw Error("Island not found!");
     }
-    return it->second;
+    return islands[id];
 }
 
 shared_ptr<Island>
 Model::is_location_island(Point location) const
 {
-    return find_if(island_map.begin(),
-                   island_map.end(),
-                   [&location](pair<string, shared_ptr<Island>> obj)
-                   {return (obj.second->get_location() == location);})->second;
+    vector<int> ids;
+    island_index.find_at(location, ids);
+
+    if (ids.empty())
+    {
+        return nullptr;
+    }
+
+    // if islands share the location, the first by name is the one
+    return islands[*min_element(ids.begin(), ids.end(), Name_order())];
 }
 
 std::vector<Point>
@@ -106,45 +167,83 @@ Model::get_island_locations() const
 {
     vector<Point> return_vector;
     
-    for_each(island_map.begin(),
-             island_map.end(),
-             [&return_vector](pair<string, shared_ptr<Island>> obj)
-             {return_vector.push_back(obj.second->get_location());});
+    for_each(island_ids.begin(),
+             island_ids.end(),
+             [this, &return_vector](int id)
+             {return_vector.push_back(islands[id]->get_location());});
     
     return return_vector;
 }
 
+vector<shared_ptr<Island>>
+Model::get_islands_within(Point location, double distance) const
+{
+    vector<int> ids;
+    island_index.find_within(location, distance, ids);
+    sort(ids.begin(), ids.end(), Name_order());
+
+    vector<shared_ptr<Island>> return_vector;
+    return_vector.reserve(ids.size());
+    for_each(ids.begin(),
+             ids.end(),
+             [this, &return_vector](int id)
+             {return_vector.push_back(islands[id]);});
+
+    return return_vector;
+}
+
 bool
 Model::is_ship_present(const string& name) const
 {
-    return (ship_map.find(name) != ship_map.end());
+    int id = find_id(name);
+    return (id != -1 && ships[id]);
 }
 
 void
 Model::add_ship(shared_ptr<Ship> ship_ptr)
 {
-    sim_object_map[ship_ptr->get_name()] =
-    ship_map[ship_ptr->get_name()]       = ship_ptr;
+    insert_ship(ship_ptr);
     ship_ptr->broadcast_current_state();
 }
 
 shared_ptr<Ship>
 Model::get_ship_ptr(const string& name) const
 {
-    map<string, shared_ptr<Ship>>::const_iterator it = ship_map.find(name);
-    if (it == ship_map.end())
+    int id = find_id(name);
+    if (id == -1 || !ships[id])
     {
         throw Error("Ship not found!");
     }
-    return it->second;
+    return ships[id];
+}
+
+shared_ptr<Ship>
+Model::get_ship_ptr(int id) const
+{
+    if (id < 0 || id >= static_cast<int>(ships.size()) || !ships[id])
+    {
+        throw Error("Ship not found!");
+    }
+    return ships[id];
+}
+
+void
+Model::add_sunk_ship(int id)
+{
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::SHIP_SUNK, id);
+        return;
+    }
+    sunk_ship_ids.push_back(id);
 }
 
 void
 Model::describe() const
 {
-    for_each(sim_object_map.begin(),
-             sim_object_map.end(),
-             [](pair<string, shared_ptr<Sim_object>> obj){obj.second->describe();});
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this](int id){sim_objects[id]->describe();});
 }
 
 // increment the time, and tell all objects to update themselves
@@ -155,29 +254,426 @@ Model::update()
     // increment time
     time++;
 
-    // update all Sim_objects
-    for_each(sim_object_map.begin(),
-             sim_object_map.end(),
-             [](pair<string, shared_ptr<Sim_object>> obj){obj.second->update();});
+    compute_updates();
+
+    // visit all Sim_objects in name order, collecting the changes
+    // they report; the intents of the active objects are applied,
+    // or they are updated if their intents were not computed,
+    // and the dormant ships between them only output their status
+    collecting_changes = &tick_changes;
+    Name_order name_order;
+    set<int, Name_order>::iterator active_it = active_ids.begin();
+    dormant_walk = dormant_ship_ids.begin();
+    while (active_it != active_ids.end() ||
+           dormant_walk != dormant_ship_ids.end())
+    {
+        if (active_it == active_ids.end() ||
+            (dormant_walk != dormant_ship_ids.end() &&
+             name_order(*dormant_walk, *active_it)))
+        {
+            ships[*dormant_walk]->output_status();
+            ++dormant_walk;
+            continue;
+        }
+
+        Intent_range& range = intent_ranges[*active_it];
+        if (range.chunk != -1)
+        {
+            chunk_intents[range.chunk].apply(range.begin, range.end);
+            range.chunk = -1;
+        }
+        else
+        {
+            sim_objects[*active_it]->update();
+        }
+        if (sim_objects[*active_it]->is_dormant())
+        {
+            active_it = make_dormant(active_it);
+        }
+        else
+        {
+            ++active_it;
+        }
+    }
+    dormant_walk = dormant_ship_ids.end();
+    collecting_changes = nullptr;
+
+    // give each view all of the changes at once
+    give_tick_changes();
+
+    // remove the ships that sank during this update
+    for_each(sunk_ship_ids.begin(),
+             sunk_ship_ids.end(),
+             [this](int id){remove_ship(id);});
+    sunk_ship_ids.clear();
+}
+
+// fewest objects worth handing to another thread
+const int min_objects_per_chunk = 256;
+
+// a ship that is fired at may be changed before its turn comes,
+// so it is left to be updated then
+void
+Model::compute_updates()
+{
+    tick_order.assign(active_ids.begin(), active_ids.end());
+    if (intent_ranges.size() < sim_objects.size())
+    {
+        Intent_range not_computed = {-1, 0, 0};
+        intent_ranges.resize(sim_objects.size(), not_computed);
+        targeted.resize(sim_objects.size(), 0);
+    }
+
+    for_each(tick_order.begin(),
+             tick_order.end(),
+             [this](int id)
+             {
+                 int target_id = sim_objects[id]->get_target_id();
+                 if (target_id != -1 && !targeted[target_id])
+                 {
+                     targeted[target_id] = 1;
+                     targeted_ids.push_back(target_id);
+                 }
+             });
+
+    int num_objects = static_cast<int>(tick_order.size());
+    int num_chunks = (num_objects + min_objects_per_chunk - 1) /
+                     min_objects_per_chunk;
+    if (static_cast<int>(chunk_intents.size()) < num_chunks)
+    {
+        chunk_intents.resize(num_chunks);
+    }
+
+    auto compute_chunks = [this](int begin, int end)
+        {
+            for (int chunk = begin; chunk < end; ++chunk)
+            {
+                compute_chunk(chunk);
+            }
+        };
+    if (num_chunks < 2)
+    {
+        compute_chunks(0, num_chunks);
+    }
+    else
+    {
+        if (!worker_pool)
+        {
+            worker_pool.reset(new Worker_pool());
+        }
+        worker_pool->parallel_for(num_chunks, 1, compute_chunks);
+    }
+
+    for_each(targeted_ids.begin(),
+             targeted_ids.end(),
+             [this](int id){targeted[id] = 0;});
+    targeted_ids.clear();
+}
+
+// each object in the chunk is computed on the same thread,
+// and only its own entry of intent_ranges is written
+void
+Model::compute_chunk(int chunk)
+{
+    int begin = chunk * min_objects_per_chunk;
+    int end = min(begin + min_objects_per_chunk,
+                  static_cast<int>(tick_order.size()));
 
-    // find all ships that are sunk and remove
-    list<shared_ptr<Ship>> delete_ship_list;
-    for_each(ship_map.begin(),
-             ship_map.end(),
-             [&delete_ship_list](pair<string, shared_ptr<Ship>> obj)
+    Tick_intents& intents = chunk_intents[chunk];
+    intents.clear();
+    intents.start_recording();
+    for (int position = begin; position < end; ++position)
+    {
+        int id = tick_order[position];
+        if (targeted[id])
+        {
+            continue;
+        }
+
+        Intent_range& range = intent_ranges[id];
+        range.chunk = chunk;
+        range.begin = intents.size();
+        sim_objects[id]->update();
+        range.end = intents.size();
+    }
+    Tick_intents::stop_recording();
+}
+
+// the names come first, then the islands, then each ship's type and
+// location so that all ships exist before any ship's state refers to one
+void
+Model::save(const string& file_name) const
+{
+    Checkpoint_writer writer;
+    writer.write_int(time);
+
+    writer.write_int(static_cast<int32_t>(sim_object_ids.size()));
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this, &writer](int id)
              {
-                 if (!obj.second->is_afloat())
+                 writer.write_int(id);
+                 writer.write_string(sim_objects[id]->get_name());
+             });
+
+    writer.write_int(static_cast<int32_t>(island_ids.size()));
+    for_each(island_ids.begin(),
+             island_ids.end(),
+             [this, &writer](int id)
+             {
+                 writer.write_int(id);
+                 writer.write_point(islands[id]->get_location());
+                 islands[id]->save_state(writer);
+             });
+
+    vector<int> ship_ids;
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this, &ship_ids](int id)
+             {
+                 if (ships[id])
                  {
-                     delete_ship_list.push_back(obj.second);
+                     ship_ids.push_back(id);
                  }
              });
-    for_each(delete_ship_list.begin(),
-             delete_ship_list.end(),
-             [this](shared_ptr<Ship> ship_ptr)
+
+    writer.write_int(static_cast<int32_t>(ship_ids.size()));
+    for_each(ship_ids.begin(),
+             ship_ids.end(),
+             [this, &writer](int id)
+             {
+                 writer.write_int(id);
+                 writer.write_string(ships[id]->get_type_name());
+                 writer.write_point(ships[id]->get_location());
+             });
+    for_each(ship_ids.begin(),
+             ship_ids.end(),
+             [this, &writer](int id){ships[id]->save_state(writer);});
+
+    writer.save(file_name);
+}
+
+void
+Model::restore(const string& file_name)
+{
+    Checkpoint_reader reader(file_name);
+    int saved_time = reader.read_int();
+
+    int num_names = reader.read_int();
+    for (int i = 0; i < num_names; ++i)
+    {
+        int saved_id = reader.read_int();
+        reader.add_id(saved_id,
+                      Name_table::get_Instance().intern(reader.read_string()));
+    }
+
+    // every object is read before the old ones are discarded,
+    // so a file damaged inside leaves the Model as it was
+    const Name_table& name_table = Name_table::get_Instance();
+    int num_islands = reader.read_int();
+    vector<shared_ptr<Island>> restored_islands;
+    restored_islands.reserve(num_islands > 0 ? num_islands : 0);
+    for (int i = 0; i < num_islands; ++i)
+    {
+        int id = reader.read_id();
+        shared_ptr<Island>
+            island_ptr(make_shared<Island>(name_table.get_name(id),
+                                           reader.read_point()));
+        island_ptr->restore_state(reader);
+        reader.add_island(island_ptr);
+        restored_islands.push_back(island_ptr);
+    }
+
+    int num_ships = reader.read_int();
+    vector<shared_ptr<Ship>> restored_ships;
+    restored_ships.reserve(num_ships > 0 ? num_ships : 0);
+    for (int i = 0; i < num_ships; ++i)
+    {
+        int id = reader.read_id();
+        string type = reader.read_string();
+        shared_ptr<Ship> ship_ptr(create_ship(name_table.get_name(id),
+                                              type,
+                                              reader.read_point()));
+        reader.add_ship(ship_ptr);
+        restored_ships.push_back(ship_ptr);
+    }
+    for_each(restored_ships.begin(),
+             restored_ships.end(),
+             [&reader](shared_ptr<Ship> ship_ptr)
+             {ship_ptr->restore_state(reader);});
+
+    // the views are told about the objects that are gone
+    // and about the restored ones in a single batch
+    vector<int> old_ids(sim_object_ids.begin(), sim_object_ids.end());
+    clear_objects();
+    time = saved_time;
+    insert_objects(restored_islands, restored_ships);
+    give_objects_to_views(old_ids);
+}
+
+void
+Model::load(const Scenario& scenario)
+{
+    // every object is created before the old ones are discarded,
+    // so a ship of an unknown type leaves the Model as it was
+    vector<shared_ptr<Island>> new_islands;
+    vector<shared_ptr<Ship>> new_ships;
+    create_objects(scenario, new_islands, new_ships);
+
+    // the old objects are kept until every order has been given,
+    // so that an order that fails can put them back
+    vector<int> old_ids(sim_object_ids.begin(), sim_object_ids.end());
+    vector<shared_ptr<Island>> old_islands;
+    vector<shared_ptr<Ship>> old_ships;
+    for_each(old_ids.begin(),
+             old_ids.end(),
+             [this, &old_islands, &old_ships](int id)
              {
-                 ship_map.erase(ship_map.find(ship_ptr->get_name()));
-                 sim_object_map.erase(sim_object_map.find(ship_ptr->get_name()));
+                 if (islands[id])
+                 {
+                     old_islands.push_back(islands[id]);
+                 }
+                 else
+                 {
+                     old_ships.push_back(ships[id]);
+                 }
              });
+    clear_objects();
+    insert_objects(new_islands, new_ships);
+
+    // the changes made by the orders go to the views
+    // in the same batch as the new objects
+    collecting_changes = &tick_changes;
+    try
+    {
+        const vector<Scenario::Order_entry>& orders = scenario.get_orders();
+        for_each(orders.begin(),
+                 orders.end(),
+                 [this](const Scenario::Order_entry& order)
+                 {
+                     shared_ptr<Ship> ship_ptr = get_ship_ptr(order.ship);
+                     switch (order.command)
+                     {
+                         case Scenario::Order_entry::COURSE:
+                             ship_ptr->set_course_and_speed(order.point.x,
+                                                            order.speed);
+                             break;
+                         case Scenario::Order_entry::POSITION:
+                             ship_ptr->set_destination_position_and_speed(
+                                 order.point, order.speed);
+                             break;
+                         case Scenario::Order_entry::DESTINATION:
+                             ship_ptr->set_destination_position_and_speed(
+                                 get_island_ptr(order.target)->get_location(),
+                                 order.speed);
+                             break;
+                         case Scenario::Order_entry::LOAD_AT:
+                             ship_ptr->set_load_destination(
+                                 get_island_ptr(order.target));
+                             break;
+                         case Scenario::Order_entry::UNLOAD_AT:
+                             ship_ptr->set_unload_destination(
+                                 get_island_ptr(order.target));
+                             break;
+                         case Scenario::Order_entry::DOCK_AT:
+                             ship_ptr->dock(get_island_ptr(order.target));
+                             break;
+                         case Scenario::Order_entry::ATTACK:
+                             ship_ptr->attack(get_ship_ptr(order.target));
+                             break;
+                         case Scenario::Order_entry::REFUEL:
+                             ship_ptr->refuel();
+                             break;
+                         case Scenario::Order_entry::STOP:
+                             ship_ptr->stop();
+                             break;
+                         case Scenario::Order_entry::STOP_ATTACK:
+                             ship_ptr->stop_attack();
+                             break;
+                     }
+                 });
+    }
+    catch (Error&)
+    {
+        // the views have not been told of the new objects yet,
+        // so only the snapshot, which the orders changed,
+        // is put back to the old objects; the messages of the
+        // orders given before the one that failed are still output
+        vector<int> new_ids(sim_object_ids.begin(), sim_object_ids.end());
+        clear_objects();
+        insert_objects(old_islands, old_ships);
+        tick_changes.clear();
+
+        Change_set discarded;
+        collecting_changes = &discarded;
+        for_each(new_ids.begin(),
+                 new_ids.end(),
+                 [this](int id)
+                 {
+                     if (!sim_objects[id])
+                     {
+                         notify_gone(id);
+                     }
+                 });
+        for_each(sim_object_ids.begin(),
+                 sim_object_ids.end(),
+                 [this](int id){sim_objects[id]->broadcast_current_state();});
+        collecting_changes = nullptr;
+        throw;
+    }
+    give_objects_to_views(old_ids);
+}
+
+void
+Model::fast_forward(int num_updates)
+{
+    while (num_updates > 0)
+    {
+        // the stretch ends when the first object is no longer quiet;
+        // dormant objects are quiet until they are woken
+        int quiet_updates = num_updates;
+        for (set<int, Name_order>::iterator it = active_ids.begin();
+             it != active_ids.end() && quiet_updates > 0;
+             ++it)
+        {
+            quiet_updates = min(quiet_updates,
+                                sim_objects[*it]->get_quiet_updates());
+        }
+
+        if (quiet_updates == 0)
+        {
+            update();
+            --num_updates;
+            continue;
+        }
+
+        time += quiet_updates;
+        collecting_changes = &tick_changes;
+        for_each(active_ids.begin(),
+                 active_ids.end(),
+                 [this, quiet_updates](int id)
+                 {sim_objects[id]->skip_updates(quiet_updates);});
+        collecting_changes = nullptr;
+        give_tick_changes();
+        num_updates -= quiet_updates;
+    }
+}
+
+void
+Model::wake(int id)
+{
+    if (!dormant[id])
+    {
+        return;
+    }
+
+    if (dormant_walk != dormant_ship_ids.end() && *dormant_walk == id)
+    {
+        ++dormant_walk;
+    }
+    dormant_ship_ids.erase(id);
+    dormant[id] = 0;
+    active_ids.insert(id);
 }
 
 void
@@ -186,11 +682,16 @@ Model::attach(shared_ptr<View> view_ptr)
     // insert view into container of view pointers
     view_array.push_back(view_ptr);
 
-    // call broadcast_current_state for all sim_objects
-    for_each(sim_object_map.begin(),
-             sim_object_map.end(),
-             [](pair<string, shared_ptr<Sim_object>> obj)
-             {obj.second->broadcast_current_state();});
+    // call broadcast_current_state for all sim_objects,
+    // collecting their state for only the new view
+    Change_set snapshot;
+    collecting_changes = &snapshot;
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this](int id){sim_objects[id]->broadcast_current_state();});
+    collecting_changes = nullptr;
+
+    view_ptr->update_changes(snapshot);
 }
 
 void
@@ -199,48 +700,347 @@ Model::detach(shared_ptr<View> view_ptr)
     view_array.erase(find(view_array.begin(), view_array.end(), view_ptr));
 }
 
+const World_snapshot&
+Model::get_world()
+{
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    return world;
+}
+
+void
+Model::notify_location(int id, Point location)
+{
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_LOCATION,
+                                  id, location.x, location.y);
+        return;
+    }
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    world.set_location(id, location);
+    if (collecting_changes)
+    {
+        collecting_changes->set_location(id, location);
+        return;
+    }
+    for_each(view_array.begin(),
+             view_array.end(),
+             [id, &location](shared_ptr<View> view_ptr)
+             {view_ptr->update_location(id, location);});
+}
+
 void
-Model::notify_location(const string& name, Point location)
+Model::notify_fuel(int id, double fuel)
 {
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_FUEL, id, fuel);
+        return;
+    }
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    world.set_fuel(id, fuel);
+    if (collecting_changes)
+    {
+        collecting_changes->set_fuel(id, fuel);
+        return;
+    }
     for_each(view_array.begin(),
              view_array.end(),
-             [&name, &location](shared_ptr<View> view_ptr)
-             {view_ptr->update_location(name, location);});
+             [id, fuel](shared_ptr<View> view_ptr)
+             {view_ptr->update_fuel(id, fuel);});
 }
 
 void
-Model::notify_fuel(const std::string& name, double fuel)
+Model::notify_speed(int id, double speed)
 {
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_SPEED, id, speed);
+        return;
+    }
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    world.set_speed(id, speed);
+    if (collecting_changes)
+    {
+        collecting_changes->set_speed(id, speed);
+        return;
+    }
     for_each(view_array.begin(),
              view_array.end(),
-             [&name, &fuel](shared_ptr<View> view_ptr)
-             {view_ptr->update_fuel(name, fuel);});
+             [id, speed](shared_ptr<View> view_ptr)
+             {view_ptr->update_speed(id, speed);});
 }
 
 void
-Model::notify_speed(const std::string& name, double speed)
+Model::notify_course(int id, double course)
 {
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_COURSE, id, course);
+        return;
+    }
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    world.set_course(id, course);
+    if (collecting_changes)
+    {
+        collecting_changes->set_course(id, course);
+        return;
+    }
     for_each(view_array.begin(),
              view_array.end(),
-             [&name, &speed](shared_ptr<View> view_ptr)
-             {view_ptr->update_speed(name, speed);});
+             [id, course](shared_ptr<View> view_ptr)
+             {view_ptr->update_course(id, course);});
 }
 
 void
-Model::notify_course(const std::string& name, double course)
+Model::notify_state(int id, int state)
 {
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_STATE, id, state);
+        return;
+    }
+    if (collecting_changes)
+    {
+        collecting_changes->set_state(id, state);
+        return;
+    }
     for_each(view_array.begin(),
              view_array.end(),
-             [&name, &course](shared_ptr<View> view_ptr)
-             {view_ptr->update_course(name, course);});
+             [id, state](shared_ptr<View> view_ptr)
+             {view_ptr->update_state(id, state);});
 }
 
 // notify the views that an object is now gone
 void
-Model::notify_gone(const string& name)
+Model::notify_gone(int id)
+{
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_notification(Tick_intents::NOTIFY_GONE, id);
+        return;
+    }
+    if (!world_filled)
+    {
+        fill_world();
+    }
+    world.set_removed(id);
+    if (collecting_changes)
+    {
+        collecting_changes->set_removed(id);
+        return;
+    }
+    for_each(view_array.begin(),
+             view_array.end(),
+             [id](shared_ptr<View> view_ptr)
+             {view_ptr->update_remove(id);});
+}
+
+int
+Model::find_id(const string& name) const
+{
+    int id = Name_table::get_Instance().find(name);
+    if (id == -1 ||
+        id >= static_cast<int>(sim_objects.size()) ||
+        !sim_objects[id])
+    {
+        return -1;
+    }
+    return id;
+}
+
+void
+Model::insert_island(shared_ptr<Island> island_ptr)
 {
+    insert_sim_object(island_ptr);
+    islands[island_ptr->get_id()] = island_ptr;
+    island_ids.insert(island_ptr->get_id());
+    island_index.insert(island_ptr->get_id(), island_ptr->get_location());
+}
+
+void
+Model::insert_ship(shared_ptr<Ship> ship_ptr)
+{
+    insert_sim_object(ship_ptr);
+    ships[ship_ptr->get_id()] = ship_ptr;
+}
+
+void
+Model::insert_sim_object(shared_ptr<Sim_object> sim_object_ptr)
+{
+    // grow the containers to cover every id handed out so far
+    int num_ids = Name_table::get_Instance().size();
+    if (static_cast<int>(sim_objects.size()) < num_ids)
+    {
+        sim_objects.resize(num_ids);
+        islands.resize(num_ids);
+        ships.resize(num_ids);
+        dormant.resize(num_ids, 0);
+    }
+
+    // a new object is updated at least once before it can be dormant
+    sim_objects[sim_object_ptr->get_id()] = sim_object_ptr;
+    sim_object_ids.insert(sim_object_ptr->get_id());
+    active_ids.insert(sim_object_ptr->get_id());
+    ++prefix_counts[name_prefix(sim_object_ptr->get_name())];
+}
+
+// the objects made with the Model cannot notify it of their state
+// while it is being made, so they do so before the snapshot
+// is first looked at or changed
+void
+Model::fill_world()
+{
+    world_filled = true;
+    Change_set initial_state;
+    Change_set* saved_collecting_changes = collecting_changes;
+    collecting_changes = &initial_state;
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this](int id){sim_objects[id]->broadcast_current_state();});
+    collecting_changes = saved_collecting_changes;
+}
+
+void
+Model::give_tick_changes()
+{
+    if (tick_changes.empty())
+    {
+        return;
+    }
+
     for_each(view_array.begin(),
              view_array.end(),
-             [&name](shared_ptr<View> view_ptr)
-             {view_ptr->update_remove(name);});
+             [this](shared_ptr<View> view_ptr)
+             {view_ptr->update_changes(tick_changes);});
+    tick_changes.clear();
+}
+
+void
+Model::remove_ship(int id)
+{
+    --prefix_counts[name_prefix(ships[id]->get_name())];
+    sim_object_ids.erase(id);
+    active_ids.erase(id);
+    dormant_ship_ids.erase(id);
+    dormant[id] = 0;
+    sim_objects[id].reset();
+    ships[id].reset();
+}
+
+void
+Model::clear_objects()
+{
+    sim_object_ids.clear();
+    island_ids.clear();
+    active_ids.clear();
+    dormant_ship_ids.clear();
+    dormant_walk = dormant_ship_ids.end();
+    dormant.clear();
+    sunk_ship_ids.clear();
+    sim_objects.clear();
+    islands.clear();
+    ships.clear();
+    island_index = Spatial_index(island_cell_size);
+    fill(prefix_counts.begin(), prefix_counts.end(), 0);
+}
+
+// the ids are put in name order first, so that each one
+// goes at the end of the sets, which takes constant time
+void
+Model::insert_objects(const vector<shared_ptr<Island>>& new_islands,
+                      const vector<shared_ptr<Ship>>& new_ships)
+{
+    int num_ids = Name_table::get_Instance().size();
+    sim_objects.resize(num_ids);
+    islands.resize(num_ids);
+    ships.resize(num_ids);
+    dormant.resize(num_ids, 0);
+
+    vector<int> ids;
+    ids.reserve(new_islands.size() + new_ships.size());
+    for_each(new_islands.begin(),
+             new_islands.end(),
+             [this, &ids](shared_ptr<Island> island_ptr)
+             {
+                 int id = island_ptr->get_id();
+                 sim_objects[id] = island_ptr;
+                 islands[id] = island_ptr;
+                 island_index.insert(id, island_ptr->get_location());
+                 ++prefix_counts[name_prefix(island_ptr->get_name())];
+                 ids.push_back(id);
+             });
+    for_each(new_ships.begin(),
+             new_ships.end(),
+             [this, &ids](shared_ptr<Ship> ship_ptr)
+             {
+                 int id = ship_ptr->get_id();
+                 sim_objects[id] = ship_ptr;
+                 ships[id] = ship_ptr;
+                 ++prefix_counts[name_prefix(ship_ptr->get_name())];
+                 ids.push_back(id);
+             });
+
+    sort(ids.begin(), ids.end(), Name_order());
+    for_each(ids.begin(),
+             ids.end(),
+             [this](int id)
+             {
+                 sim_object_ids.insert(sim_object_ids.end(), id);
+                 active_ids.insert(active_ids.end(), id);
+                 if (islands[id])
+                 {
+                     island_ids.insert(island_ids.end(), id);
+                 }
+             });
+}
+
+void
+Model::give_objects_to_views(const vector<int>& old_ids)
+{
+    collecting_changes = &tick_changes;
+    for_each(old_ids.begin(),
+             old_ids.end(),
+             [this](int id)
+             {
+                 if (id >= static_cast<int>(sim_objects.size()) ||
+                     !sim_objects[id])
+                 {
+                     notify_gone(id);
+                 }
+             });
+    for_each(sim_object_ids.begin(),
+             sim_object_ids.end(),
+             [this](int id){sim_objects[id]->broadcast_current_state();});
+    collecting_changes = nullptr;
+    give_tick_changes();
+}
+
+set<int, Name_order>::iterator
+Model::make_dormant(set<int, Name_order>::iterator active_it)
+{
+    int id = *active_it;
+    dormant[id] = 1;
+
+    // a ship still outputs its status while dormant
+    if (ships[id])
+    {
+        dormant_ship_ids.insert(id);
+    }
+    return active_ids.erase(active_it);
 }
@@ -12,7 +12,10 @@
     It has facilities for looking up objects by name,
     and removing Ships.  When
     created, it creates an initial group of Islands
-    and Ships using the Ship_factory.
+    and Ships from a built-in Scenario, using the Ship_factory,
+    and it can replace all of its objects with those of another.
+    Objects are placed in the containers all at once when
+    they come from a Scenario.
     Finally, it keeps the system's time.
 
     Controller tells Model what to do; Model in turn
@@ -20,10 +23,31 @@
     when asked to do so by an object, tells all
     the Views whenever anything changes that might be relevant.
     Model also provides facilities for looking up objects given their name.
+    Objects are kept by the id of their name in the Name_table,
+    and the Views are notified by id, so names are only compared
+    when the user supplies one.
+    Every notification also changes the World_snapshot, which the
+    Views that are not attached read when they draw.
+
+    A tick is made in two phases. In the compute phase, the updates
+    of the active objects are computed on all of the cores, each
+    object changing only itself, with what it would output, notify
+    or do to other objects kept as its Tick_intents. In the commit
+    phase, the objects are visited in name order, and the intents
+    of each are applied, so that the output and every change happen
+    in the same order as if the objects were updated one at a time.
+    A ship that is fired at during the tick, or is woken by a hit,
+    is updated at its turn in the commit phase instead.
 ***************************************************************************/
 
+#include "Name_table.h"
+#include "Spatial_index.h"
+#include "Change_set.h"
+#include "World_snapshot.h"
+#include "Tick_intents.h"
+#include "Worker_pool.h"
 #include <vector>
-#include <map>
+#include <set>
 #include <string>
 #include <memory>
 
@@ -33,6 +57,7 @@ class Sim_object;
 class Island;
 class Ship;
 class View;
+class Scenario;
 
 class Model
 {
@@ -63,6 +88,9 @@ class Model
 
       // will throw Error("Island not found!") if no island of that name
       std::shared_ptr<Island> get_island_ptr(const std::string&) const;
+
+      // will throw Error("Island not found!") if no island has the id
+      std::shared_ptr<Island> get_island_ptr(int) const;
     
       // return island if there is an island located at location
       // else, return a nullptr
@@ -71,15 +99,36 @@ class Model
       // return locations of all islands
       std::vector<Point> get_island_locations() const;
 
+      // return the number of islands
+      int get_island_count() const
+          {return static_cast<int>(island_ids.size());}
+
+      // return the islands no further than a distance
+      // from a location, in name order
+      std::vector<std::shared_ptr<Island>>
+          get_islands_within(Point, double) const;
+
       // is there such an ship?
       bool is_ship_present(const std::string&) const;
 
+      // is there a ship with the id of its name?
+      bool is_ship_present(int id) const
+          {return id >= 0 &&
+                  id < static_cast<int>(ships.size()) &&
+                  ships[id];}
+
       // add a new ship to the list, and update the view
       void add_ship(std::shared_ptr<Ship>);
 
       // will throw Error("Ship not found!") if no ship of that name
       std::shared_ptr<Ship> get_ship_ptr(const std::string&) const;
 
+      // will throw Error("Ship not found!") if no ship has the id
+      std::shared_ptr<Ship> get_ship_ptr(int) const;
+
+      // a ship has sunk, and is to be removed at the end of the update
+      void add_sunk_ship(int);
+
       // tell all objects to describe themselves
       void describe() const;
 
@@ -87,11 +136,41 @@ class Model
       // all objects to update themselves
       void update();  
 
+      // write the time and every object to a checkpoint file
+      void save(const std::string&) const;
+
+      // replace the time and every object with those in a checkpoint
+      // file, and give the views the new objects; every object is read
+      // before any is replaced, so if the file cannot be read,
+      // the Model is left as it was
+      void restore(const std::string&);
+
+      // replace every object with those of the scenario, give the
+      // ships their orders, and give the views the new objects;
+      // the time is kept; if a ship cannot carry out its order,
+      // the old objects are put back and the error is thrown,
+      // so the Model is left as it was
+      // will throw Error("Trying to create ship of unknown type!")
+      void load(const Scenario&);
+
+      // advance the time by a number of updates, making each stretch
+      // of updates in which every object is quiet all at once
+      // and without output; the updates in which anything else
+      // happens are made one at a time as usual, so the caller
+      // that wants no output at all must discard their messages
+      void fast_forward(int);
+
+      // an object whose state is about to change by other means
+      // than its own update is to be updated again;
+      // no effect if it already is
+      void wake(int);
+
       /* View services */
       // Attaching a View adds it to the
       // container and causes it to be updated
       // with all current objects'location
-      // (or other state information.
+      // (or other state information), given to
+      // only that View in a single batch.
       void attach(std::shared_ptr<View>);
 
       // Detach the View by discarding the
@@ -99,16 +178,30 @@ class Model
       // - no updates sent to it thereafter.
       void detach(std::shared_ptr<View>);
 
-      // notify the views about an object's location
-      void notify_location(const std::string&, Point);
+      // the latest state of every object, which the views read
+      // when they draw; it is changed by the notifications below
+      const World_snapshot& get_world();
+
+      // the moves listed in the snapshot have all been drawn
+      void clear_world_moves()
+          {world.clear_moves();}
+
+      // notify the views about an object's location, given its id;
+      // during update, the changes are collected and given to
+      // each view together when all objects have been updated
+      void notify_location(int, Point);
     
       // notify the views about object's fuel, speed, and course
-      void notify_fuel(const std::string&, double);
-      void notify_speed(const std::string&, double);
-      void notify_course(const std::string&, double);
+      void notify_fuel(int, double);
+      void notify_speed(int, double);
+      void notify_course(int, double);
+
+      // notify the views about a ship's movement state,
+      // given as a Ship_kinematics::State_e
+      void notify_state(int, int);
 
       // notify the views that an object is now gone
-      void notify_gone(const std::string&);
+      void notify_gone(int);
 
   private:
       // create the initial objects
@@ -118,10 +211,115 @@ class Model
       ~Model();
 
       int time;
-      std::map<std::string, std::shared_ptr<Sim_object>> sim_object_map;
-      std::map<std::string, std::shared_ptr<Island>> island_map;
-      std::map<std::string, std::shared_ptr<Ship>> ship_map;
+
+      // objects indexed by id, with an empty pointer for an unused id
+      std::vector<std::shared_ptr<Sim_object>> sim_objects;
+      std::vector<std::shared_ptr<Island>> islands;
+      std::vector<std::shared_ptr<Ship>> ships;
+
+      // ids of all objects, and of the islands, in name order
+      std::set<int, Name_order> sim_object_ids;
+      std::set<int, Name_order> island_ids;
+
+      // ids of the objects that must be updated, and of the dormant
+      // ships that only output their status, in name order;
+      // dormant islands do nothing, so they are in neither
+      std::set<int, Name_order> active_ids;
+      std::set<int, Name_order> dormant_ship_ids;
+
+      // whether each object is dormant, indexed by id
+      std::vector<char> dormant;
+
+      // next dormant ship to be visited during update,
+      // kept valid when a ship is woken during the walk
+      std::set<int, Name_order>::iterator dormant_walk;
+
+      // island locations, for finding islands by location
+      Spatial_index island_index;
+
+      // ids of ships that sank during the current update
+      std::vector<int> sunk_ship_ids;
+
+      // the active objects as the current update started, in name order,
+      // and the intents of those in each chunk of them
+      std::vector<int> tick_order;
+      std::vector<Tick_intents> chunk_intents;
+
+      // where each object's intents are in chunk_intents, by id;
+      // the chunk is -1 for an object whose update was not computed
+      struct Intent_range
+      {
+          int chunk;
+          int begin;
+          int end;
+      };
+      std::vector<Intent_range> intent_ranges;
+
+      // whether each object is fired at during the current update,
+      // by id, and the ids that are
+      std::vector<char> targeted;
+      std::vector<int> targeted_ids;
+
+      // created only once there are enough objects to be worth sharing
+      std::unique_ptr<Worker_pool> worker_pool;
+
+      // number of objects whose name starts with each pair of characters,
+      // indexed by the two characters taken as a 16-bit value
+      std::vector<int> prefix_counts;
+
       std::vector<std::shared_ptr<View>> view_array;
+
+      // the state of the objects as the views see it, and whether
+      // the objects made with the Model have been put in it
+      World_snapshot world;
+      bool world_filled;
+
+      // changes made during update, waiting to be given to the views
+      Change_set tick_changes;
+
+      // where notifications are collected instead of being
+      // given to the views, or nullptr to give them right away
+      Change_set* collecting_changes;
+
+      // return the id of the name if an object has it, else -1
+      int find_id(const std::string&) const;
+
+      // put the objects made with the Model into the snapshot
+      void fill_world();
+
+      // give each view the changes collected in tick_changes
+      void give_tick_changes();
+
+      // compute the updates of the active objects that are not
+      // fired at into their intents, on all of the cores
+      void compute_updates();
+
+      // compute the updates of the objects in a chunk of tick_order
+      void compute_chunk(int chunk);
+
+      // take an object out of the containers for its id
+      void remove_ship(int);
+
+      // empty all of the containers of objects
+      void clear_objects();
+
+      // place new objects in the empty containers in one pass
+      void insert_objects(const std::vector<std::shared_ptr<Island>>&,
+                          const std::vector<std::shared_ptr<Ship>>&);
+
+      // give the views the objects that replaced those with old_ids,
+      // together with any changes already collected in tick_changes
+      void give_objects_to_views(const std::vector<int>& old_ids);
+
+      // take an object that has become dormant out of active_ids
+      // and return the iterator to the id following it
+      std::set<int, Name_order>::iterator
+          make_dormant(std::set<int, Name_order>::iterator);
+
+      // place an object in the containers for its id
+      void insert_island(std::shared_ptr<Island>);
+      void insert_ship(std::shared_ptr<Ship>);
+      void insert_sim_object(std::shared_ptr<Sim_object>);
 };
 
 #endif
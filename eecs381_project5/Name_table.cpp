@@ -0,0 +1,42 @@
+#include "Name_table.h"
+
+using namespace std;
+
+Name_table&
+Name_table::get_Instance()
+{
+    static Name_table name_table;
+    return name_table;
+}
+
+Name_table::Name_table()
+{}
+
+Name_table::~Name_table()
+{}
+
+int
+Name_table::intern(const string& name)
+{
+    unordered_map<string, int>::const_iterator it = ids.find(name);
+    if (it != ids.end())
+    {
+        return it->second;
+    }
+
+    int id = static_cast<int>(names.size());
+    names.push_back(name);
+    ids[name] = id;
+    return id;
+}
+
+int
+Name_table::find(const string& name) const
+{
+    unordered_map<string, int>::const_iterator it = ids.find(name);
+    if (it == ids.end())
+    {
+        return -1;
+    }
+    return it->second;
+}
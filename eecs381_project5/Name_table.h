@@ -0,0 +1,63 @@
+#ifndef NAME_TABLE_H
+#define NAME_TABLE_H
+
+/***************************************************************************
+    Name_table interns the names of the Sim_objects.
+    Each distinct name is given a small integer id the first time
+    it is seen, and the ids are dense, starting at zero,
+    so they can be used to index arrays.
+    The rest of the system refers to objects by id,
+    and only looks up the name when it has to be printed
+    or when a name typed by the user has to be found.
+    A name keeps its id for the whole run, so an object created
+    again with the name of a removed object gets the same id.
+***************************************************************************/
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+
+class Name_table
+{
+  public:
+      // force Name_table as a singleton object
+      static Name_table& get_Instance();
+
+      // forbid copy/move, construction/assignment
+      Name_table(const Name_table&) = delete;
+      Name_table(Name_table&&) = delete;
+      Name_table& operator= (const Name_table&) = delete;
+      Name_table& operator= (Name_table&&) = delete;
+
+      // return the id of the name, giving it a new id if it has none
+      int intern(const std::string&);
+
+      // return the id of the name, or -1 if it has never been interned
+      int find(const std::string&) const;
+
+      // return the name for an id
+      const std::string& get_name(int id) const
+          {return names[id];}
+
+      // number of ids handed out so far
+      int size() const
+          {return static_cast<int>(names.size());}
+
+  private:
+      Name_table();
+      ~Name_table();
+
+      // a deque keeps references to the names valid as it grows
+      std::deque<std::string> names;
+      std::unordered_map<std::string, int> ids;
+};
+
+// compare ids by their names, for keeping ids in name order
+struct Name_order
+{
+    bool operator() (int lhs, int rhs) const
+        {return Name_table::get_Instance().get_name(lhs) <
+                Name_table::get_Instance().get_name(rhs);}
+};
+
+#endif
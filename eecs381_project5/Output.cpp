@@ -0,0 +1,261 @@
+#include "Output.h"
+#include "Model.h"
+#include "Name_table.h"
+#include "Geometry.h"
+#include "Navigation.h"
+#include "Utility.h"
+#include "Tick_intents.h"
+#include <iostream>
+
+using namespace std;
+
+Text_output_sink::Text_output_sink()
+{
+    buffer.copyfmt(cout);
+}
+
+// each kind of message is written as the line it has always been
+void
+Text_output_sink::write(const Event& event)
+{
+    const Name_table& name_table = Name_table::get_Instance();
+    const string& name = name_table.get_name(event.id);
+    const double* value = event.value;
+
+    // the message reads as "name <what>", except for Islands
+    switch (event.type)
+    {
+        case SHIP_SUNK:
+            buffer << name << " sunk";
+            break;
+        case SHIP_NOW_AT:
+            buffer << name << " now at " << Point(value[0], value[1]);
+            break;
+        case SHIP_DOCKED_AT:
+        case SHIP_DOCKS_AT:
+            buffer << name << " docked at "
+                   << name_table.get_name(event.other_id);
+            break;
+        case SHIP_STOPPED_AT:
+            buffer << name << " stopped at " << Point(value[0], value[1]);
+            break;
+        case SHIP_DEAD_AT:
+            buffer << name << " dead in the water at "
+                   << Point(value[0], value[1]);
+            break;
+        case SHIP_WILL_SAIL_TO:
+            buffer << name << " will sail on "
+                   << Course_speed(value[0], value[1]) << " to "
+                   << Point(value[2], value[3]);
+            break;
+        case SHIP_WILL_SAIL:
+            buffer << name << " will sail on "
+                   << Course_speed(value[0], value[1]);
+            break;
+        case SHIP_STOPPING_AT:
+            buffer << name << " stopping at " << Point(value[0], value[1]);
+            break;
+        case SHIP_REFUELED:
+            buffer << name << " now has " << value[0] << " tons of fuel";
+            break;
+        case SHIP_HIT:
+            buffer << name << " hit with "
+                   << static_cast<int>(value[0]) << ", resistance now "
+                   << static_cast<int>(value[1]);
+            break;
+        case ISLAND_SUPPLIED:
+            buffer << "Island " << name << " supplied "
+                   << value[0] << " tons of fuel";
+            break;
+        case ISLAND_NOW_HAS:
+            buffer << "Island " << name << " now has "
+                   << value[0] << " tons";
+            break;
+        case TANKER_WILL_LOAD_AT:
+            buffer << name << " will load at "
+                   << name_table.get_name(event.other_id);
+            break;
+        case TANKER_WILL_UNLOAD_AT:
+            buffer << name << " will unload at "
+                   << name_table.get_name(event.other_id);
+            break;
+        case TANKER_NO_DESTINATIONS:
+            buffer << name << " now has no cargo destinations";
+            break;
+        case TANKER_CARGO:
+            buffer << name << " now has " << value[0] << " of cargo";
+            break;
+        case WARSHIP_ATTACKING:
+            buffer << name << " is attacking ";
+            break;
+        case WARSHIP_WILL_ATTACK:
+            buffer << name << " will attack "
+                   << name_table.get_name(event.other_id);
+            break;
+        case WARSHIP_STOPPING_ATTACK:
+            buffer << name << " stopping attack";
+            break;
+        case WARSHIP_FIRES:
+            buffer << name << " fires";
+            break;
+        case WARSHIP_OUT_OF_RANGE:
+            buffer << name << " target is out of range";
+            break;
+        case CRUISE_WILL_VISIT:
+            buffer << name << " will visit "
+                   << name_table.get_name(event.other_id);
+            break;
+        case CRUISE_WILL_START_AT:
+            buffer << name << " cruise will start and end at "
+                   << name_table.get_name(event.other_id);
+            break;
+        case CRUISE_OVER_AT:
+            buffer << name << " cruise is over at "
+                   << name_table.get_name(event.other_id);
+            break;
+        case CRUISE_CANCELING:
+            buffer << name << " canceling current cruise";
+            break;
+        case NUM_EVENT_TYPES:
+            break;
+    }
+    buffer << '\n';
+}
+
+void
+Text_output_sink::flush()
+{
+    cout << buffer.str();
+    buffer.str("");
+}
+
+Quiet_output_sink::Quiet_output_sink() :
+    counts(NUM_EVENT_TYPES, 0),
+    total_count(0)
+{}
+
+Binary_output_sink::Binary_output_sink(const string& file_name) :
+    file(file_name.c_str(), ios::out | ios::binary | ios::trunc)
+{
+    if (!file)
+    {
+        throw Error("Could not open output file!");
+    }
+}
+
+void
+Binary_output_sink::write(const Event& event)
+{
+    Record record = {Model::get_Instance().get_time(),
+                     event.type,
+                     event.id,
+                     event.other_id,
+                     {event.value[0],
+                      event.value[1],
+                      event.value[2],
+                      event.value[3]}};
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+void
+Binary_output_sink::flush()
+{
+    file.flush();
+}
+
+Output&
+Output::get_Instance()
+{
+    static Output output;
+    return output;
+}
+
+Output::Output() :
+    sink(make_shared<Text_output_sink>())
+{}
+
+Output::~Output()
+{
+    sink->flush();
+}
+
+void
+Output::set_sink(shared_ptr<Output_sink> sink_)
+{
+    sink->flush();
+    sink = sink_;
+}
+
+void
+Output::write(Output_sink::Event_e type, int id)
+{
+    write(type, id, -1, 0., 0., 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type, int id, int other_id)
+{
+    write(type, id, other_id, 0., 0., 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type, int id, double value)
+{
+    write(type, id, -1, value, 0., 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type, int id, double value0, double value1)
+{
+    write(type, id, -1, value0, value1, 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type, int id, Point point)
+{
+    write(type, id, -1, point.x, point.y, 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type, int id, Course_speed course_speed)
+{
+    write(type, id, -1, course_speed.course, course_speed.speed, 0., 0.);
+}
+
+void
+Output::write(Output_sink::Event_e type,
+              int id,
+              Course_speed course_speed,
+              Point point)
+{
+    write(type, id, -1,
+          course_speed.course, course_speed.speed, point.x, point.y);
+}
+
+void
+Output::write(Output_sink::Event_e type,
+              int id,
+              int other_id,
+              double value0,
+              double value1,
+              double value2,
+              double value3)
+{
+    Output_sink::Event event = {type,
+                                id,
+                                other_id,
+                                {value0, value1, value2, value3}};
+    write(event);
+}
+
+void
+Output::write(const Output_sink::Event& event)
+{
+    if (Tick_intents* intents = Tick_intents::get_recording())
+    {
+        intents->add_event(event);
+        return;
+    }
+
+    sink->write(event);
+}
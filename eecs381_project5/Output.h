@@ -0,0 +1,195 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+/***************************************************************************
+    Output is where the Sim_objects send the messages that report
+    what they are doing, instead of writing them to cout.
+    Each message is an Event: what kind of message it is, the id of
+    the object it is about, possibly the id of another object
+    (an Island or a target), and up to four numbers.
+    Output passes the Events to the current Output_sink:
+
+    Text_output_sink formats each Event as the line of text that
+    used to be written to cout, but keeps the text until flush(),
+    which the Controller calls once per command.
+    Quiet_output_sink only counts the Events of each kind.
+    Binary_output_sink writes each Event to a file as a fixed-size
+    record, stamped with the time of the Model.
+
+    Anything written directly to cout must come after a flush(),
+    so that it appears after the messages reported before it.
+***************************************************************************/
+
+#include <memory>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+
+// incomplete forward declarations
+struct Point;
+struct Course_speed;
+
+class Output_sink
+{
+  public:
+      // kinds of messages, with the numbers each one carries
+      enum Event_e
+      {
+          SHIP_SUNK,                  // ship
+          SHIP_NOW_AT,                // ship, x, y
+          SHIP_DOCKED_AT,             // ship, island
+          SHIP_STOPPED_AT,            // ship, x, y
+          SHIP_DEAD_AT,               // ship, x, y
+          SHIP_WILL_SAIL_TO,          // ship, course, speed, x, y
+          SHIP_WILL_SAIL,             // ship, course, speed
+          SHIP_STOPPING_AT,           // ship, x, y
+          SHIP_DOCKS_AT,              // ship, island
+          SHIP_REFUELED,              // ship, fuel
+          SHIP_HIT,                   // ship, hit force, resistance
+          ISLAND_SUPPLIED,            // island, fuel supplied
+          ISLAND_NOW_HAS,             // island, fuel
+          TANKER_WILL_LOAD_AT,        // tanker, island
+          TANKER_WILL_UNLOAD_AT,      // tanker, island
+          TANKER_NO_DESTINATIONS,     // tanker
+          TANKER_CARGO,               // tanker, cargo
+          WARSHIP_ATTACKING,          // warship
+          WARSHIP_WILL_ATTACK,        // warship, target
+          WARSHIP_STOPPING_ATTACK,    // warship
+          WARSHIP_FIRES,              // warship
+          WARSHIP_OUT_OF_RANGE,       // warship
+          CRUISE_WILL_VISIT,          // cruise ship, island
+          CRUISE_WILL_START_AT,       // cruise ship, island
+          CRUISE_OVER_AT,             // cruise ship, island
+          CRUISE_CANCELING,           // cruise ship
+          NUM_EVENT_TYPES
+      };
+
+      struct Event
+      {
+          Event_e type;
+          int id;
+          int other_id;   // -1 if the message has none
+          double value[4];
+      };
+
+      virtual ~Output_sink()
+          {}
+
+      // take one message
+      virtual void write(const Event&) = 0;
+
+      // hand on all of the messages taken since the last flush
+      virtual void flush()
+          {}
+};
+
+class Text_output_sink : public Output_sink
+{
+  public:
+      Text_output_sink();
+
+      void write(const Event&) override;
+
+      // write the buffered text to cout, which is flushed
+      // when the Controller waits for input
+      void flush() override;
+
+  private:
+      // formatted the same way as cout
+      std::ostringstream buffer;
+};
+
+class Quiet_output_sink : public Output_sink
+{
+  public:
+      Quiet_output_sink();
+
+      void write(const Event& event) override
+          {++counts[event.type]; ++total_count;}
+
+      // number of messages of a kind, and of all kinds
+      int get_count(Event_e type) const
+          {return counts[type];}
+      int get_total_count() const
+          {return total_count;}
+
+  private:
+      std::vector<int> counts;
+      int total_count;
+};
+
+class Binary_output_sink : public Output_sink
+{
+  public:
+      // will throw Error("Could not open output file!")
+      explicit Binary_output_sink(const std::string& file_name);
+
+      void write(const Event&) override;
+      void flush() override;
+
+      // layout of a record in the file, in the byte order of the host
+      struct Record
+      {
+          int time;
+          int type;
+          int id;
+          int other_id;
+          double value[4];
+      };
+
+  private:
+      std::ofstream file;
+};
+
+class Output
+{
+  public:
+      // force Output as a singleton object
+      static Output& get_Instance();
+
+      // forbid copy/move, construction/assignment
+      Output(const Output&) = delete;
+      Output(Output&&) = delete;
+      Output& operator= (const Output&) = delete;
+      Output& operator= (Output&&) = delete;
+
+      // the sink that now takes the messages;
+      // the previous sink is flushed first
+      void set_sink(std::shared_ptr<Output_sink>);
+      std::shared_ptr<Output_sink> get_sink() const
+          {return sink;}
+
+      // send a message to the sink
+      void write(Output_sink::Event_e type, int id);
+      void write(Output_sink::Event_e type, int id, int other_id);
+      void write(Output_sink::Event_e type, int id, double value);
+      void write(Output_sink::Event_e type, int id, double, double);
+      void write(Output_sink::Event_e type, int id, Point);
+      void write(Output_sink::Event_e type, int id, Course_speed);
+      void write(Output_sink::Event_e type, int id, Course_speed, Point);
+
+      // send a message already made; while a Tick_intents is
+      // recording on this thread, it is added to that instead
+      void write(const Output_sink::Event&);
+
+      // hand on the messages taken so far
+      void flush()
+          {sink->flush();}
+
+  private:
+      Output();
+      ~Output();
+
+      std::shared_ptr<Output_sink> sink;
+
+      void write(Output_sink::Event_e type,
+                 int id,
+                 int other_id,
+                 double value0,
+                 double value1,
+                 double value2,
+                 double value3);
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "Renderer.h"
+#include "Views.h"
+#include "Utility.h"
+#include <iostream>
+#include <algorithm>
+#include <csignal>
+#include <pthread.h>
+
+using namespace std;
+
+// the file is written with the same format as cout
+Renderer::Renderer(const string& file_name) :
+    file(file_name.c_str(), ios::out | ios::trunc),
+    back_time(0),
+    back_waiting(false),
+    frame_number(0),
+    back_frame_number(0),
+    drawing(false),
+    stopping(false)
+{
+    if (!file)
+    {
+        throw Error("Could not open render file!");
+    }
+    file.flags(cout.flags());
+    file.precision(cout.precision());
+
+    render_thread = thread(&Renderer::render_loop, this);
+}
+
+Renderer::~Renderer()
+{
+    {
+        lock_guard<mutex> lock(render_mutex);
+        stopping = true;
+    }
+    frame_ready.notify_one();
+    render_thread.join();
+}
+
+// the copy is made under the lock, but the render thread only holds it
+// to swap the buffers, so it is not held up while drawing
+void
+Renderer::publish(const vector<shared_ptr<View>>& views,
+                  const World_snapshot& world,
+                  int time)
+{
+    {
+        lock_guard<mutex> lock(render_mutex);
+        if (back_waiting)
+        {
+            back_world.merge_from(world);
+        }
+        else
+        {
+            back_world.copy_from(world);
+        }
+        back_views = views;
+        back_time = time;
+        back_frame_number = ++frame_number;
+        back_waiting = true;
+    }
+    frame_ready.notify_one();
+}
+
+void
+Renderer::wait_idle()
+{
+    unique_lock<mutex> lock(render_mutex);
+    frame_done.wait(lock, [this]{return !back_waiting && !drawing;});
+}
+
+// a reader that goes away would raise SIGPIPE, which is blocked
+// on this thread so that the write fails instead; once the file
+// has failed, the views are only cleared, so that they draw
+// whole again when they are next drawn on cout
+void
+Renderer::render_loop()
+{
+    sigset_t pipe_signal;
+    sigemptyset(&pipe_signal);
+    sigaddset(&pipe_signal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_signal, nullptr);
+
+    View::set_draw_context(&front_world, &file);
+    bool failed = false;
+
+    while (true)
+    {
+        int time, number;
+        {
+            unique_lock<mutex> lock(render_mutex);
+            frame_ready.wait(lock, [this]{return back_waiting || stopping;});
+            if (!back_waiting)
+            {
+                break;
+            }
+            front_world.swap(back_world);
+            front_views.swap(back_views);
+            time = back_time;
+            number = back_frame_number;
+            back_waiting = false;
+            drawing = true;
+        }
+
+        if (failed)
+        {
+            for_each(front_views.begin(),
+                     front_views.end(),
+                     [](shared_ptr<View> view_ptr){view_ptr->clear();});
+        }
+        else
+        {
+            file << "----- Frame " << number << " at time " << time << " -----\n";
+            for_each(front_views.begin(),
+                     front_views.end(),
+                     [](shared_ptr<View> view_ptr){view_ptr->draw();});
+            file.flush();
+            failed = !file;
+        }
+        front_views.clear();
+
+        {
+            lock_guard<mutex> lock(render_mutex);
+            drawing = false;
+        }
+        frame_done.notify_all();
+    }
+
+    View::set_draw_context(nullptr, nullptr);
+}
@@ -0,0 +1,89 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+/***************************************************************************
+    A Renderer draws the Views on a thread of its own, writing them
+    to a file or named pipe, so that a slow reader or a large view
+    does not hold up the simulation.
+    A frame is published by copying the Model's World_snapshot into
+    a back buffer along with the views to draw; the render thread
+    swaps it with its front buffer and draws from that while the
+    next frame is being published. Only one frame waits at a time:
+    if the render thread is still busy when another one is published,
+    the waiting frame is merged into the new one, and is not drawn.
+    Each frame starts with a line giving its number and the time,
+    so a gap in the numbers shows where frames were merged.
+    If the file cannot be written, as when the reader of a pipe
+    goes away, the frames are no longer drawn to it.
+    The Views, and the Name_table they draw the names from, may only
+    be changed while the renderer is idle; the Controller waits for
+    that before any command that changes one or adds a name.
+***************************************************************************/
+
+#include "World_snapshot.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class View;
+
+class Renderer
+{
+  public:
+      // open the file and start the render thread;
+      // opening a named pipe waits for its reader
+      // will throw Error("Could not open render file!")
+      explicit Renderer(const std::string& file_name);
+
+      // draw the frame that is waiting, then stop the render thread
+      ~Renderer();
+
+      // forbid copy/move, construction/assignment
+      Renderer(const Renderer&) = delete;
+      Renderer(Renderer&&) = delete;
+      Renderer& operator= (const Renderer&) = delete;
+      Renderer& operator= (Renderer&&) = delete;
+
+      // hand over a frame of the views, drawn from a copy of the world
+      // at the time; replaces the frame waiting, if there is one
+      void publish(const std::vector<std::shared_ptr<View>>& views,
+                   const World_snapshot& world,
+                   int time);
+
+      // wait until no frame is waiting or being drawn
+      void wait_idle();
+
+  private:
+      std::ofstream file;
+
+      std::mutex render_mutex;
+      std::condition_variable frame_ready;
+      std::condition_variable frame_done;
+
+      // the frame waiting to be drawn
+      World_snapshot back_world;
+      std::vector<std::shared_ptr<View>> back_views;
+      int back_time;
+      bool back_waiting;
+
+      // the frame being drawn, used only by the render thread
+      World_snapshot front_world;
+      std::vector<std::shared_ptr<View>> front_views;
+
+      int frame_number;
+      int back_frame_number;
+      bool drawing;
+      bool stopping;
+
+      // started last, once everything it uses is ready
+      std::thread render_thread;
+
+      // wait for frames and draw them until the renderer is destroyed
+      void render_loop();
+};
+
+#endif
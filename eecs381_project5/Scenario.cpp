@@ -0,0 +1,623 @@
+#include "Scenario.h"
+#include "Worker_pool.h"
+#include "Utility.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+
+using namespace std;
+
+// first and last bytes of every binary scenario file
+const char scenario_magic[4] = {'P', '5', 'S', 'N'};
+
+// version of the layout of a binary scenario file
+const uint32_t scenario_version = 1;
+
+// fewest bytes of text worth handing to another thread
+const size_t min_bytes_per_piece = 1 << 20;
+
+inline bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// skip the blanks before the next word of the line ending at end
+inline const char* skip_line_blanks(const char* next, const char* end)
+{
+    while (next != end && is_blank(*next))
+    {
+        ++next;
+    }
+    return next;
+}
+
+// read the next word of the line, or return false if there is none
+inline bool read_word(const char*& next, const char* end, string& word)
+{
+    next = skip_line_blanks(next, end);
+    const char* first = next;
+    while (next != end && !is_blank(*next))
+    {
+        ++next;
+    }
+    word.assign(first, next);
+    return next != first;
+}
+
+// read the next word of the line as a double;
+// the text is null-terminated, so strtod stops at the end of it
+inline bool read_number(const char*& next, const char* end, double& value)
+{
+    next = skip_line_blanks(next, end);
+    if (next == end)
+    {
+        return false;
+    }
+
+    char* after;
+    value = strtod(next, &after);
+    if (after == next || (after != end && !is_blank(*after)))
+    {
+        return false;
+    }
+    next = after;
+    return true;
+}
+
+inline double read_double(const char*& next, const char* end)
+{
+    double value;
+    if (!read_number(next, end, value))
+    {
+        throw Error("Expected a double!");
+    }
+    return value;
+}
+
+inline double read_speed(const char*& next, const char* end)
+{
+    double speed = read_double(next, end);
+    if (speed < 0.)
+    {
+        throw Error("Negative speed entered!");
+    }
+    return speed;
+}
+
+inline string read_name(const char*& next, const char* end)
+{
+    string name;
+    if (!read_word(next, end, name))
+    {
+        throw Error("Scenario file is damaged!");
+    }
+    return name;
+}
+
+void
+Scenario::read(const string& file_name)
+{
+    ifstream file(file_name.c_str(), ios::in | ios::binary);
+    if (!file)
+    {
+        throw Error("Could not read scenario file!");
+    }
+
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    file.seekg(0, ios::beg);
+    if (size < 0)
+    {
+        throw Error("Could not read scenario file!");
+    }
+
+    vector<char> contents(static_cast<size_t>(size));
+    if (size > 0 && !file.read(&contents[0], size))
+    {
+        throw Error("Could not read scenario file!");
+    }
+
+    if (contents.size() >= sizeof(scenario_magic) &&
+        !memcmp(&contents[0], scenario_magic, sizeof(scenario_magic)))
+    {
+        read_binary(contents);
+    }
+    else
+    {
+        parse_text(string(contents.begin(), contents.end()));
+    }
+}
+
+// the pieces are parsed into scenarios of their own,
+// which are then appended in the order of the pieces
+void
+Scenario::parse_text(const string& text)
+{
+    islands.clear();
+    ships.clear();
+    orders.clear();
+
+    const char* first = text.c_str();
+    const char* last = first + text.size();
+
+    size_t max_pieces = 4 * (Worker_pool::default_num_workers() + 1);
+    size_t num_pieces = min(text.size() / min_bytes_per_piece, max_pieces);
+    if (num_pieces < 2)
+    {
+        parse_lines(first, last);
+        check();
+        return;
+    }
+
+    // each piece ends just after a newline
+    vector<const char*> bounds(num_pieces + 1, last);
+    bounds[0] = first;
+    for (size_t i = 1; i < num_pieces; ++i)
+    {
+        const char* cut = max(first + i * text.size() / num_pieces,
+                              bounds[i - 1]);
+        const char* newline =
+            static_cast<const char*>(memchr(cut, '\n', last - cut));
+        bounds[i] = newline ? newline + 1 : last;
+    }
+
+    vector<Scenario> pieces(num_pieces);
+    vector<const char*> errors(num_pieces, nullptr);
+    {
+        Worker_pool worker_pool;
+        worker_pool.parallel_for(static_cast<int>(num_pieces),
+                                 1,
+                                 [&pieces, &errors, &bounds](int begin, int end)
+                                 {
+                                     for (int i = begin; i < end; ++i)
+                                     {
+                                         try
+                                         {
+                                             pieces[i].parse_lines(bounds[i],
+                                                                   bounds[i + 1]);
+                                         }
+                                         catch (Error& error)
+                                         {
+                                             errors[i] = error.msg;
+                                         }
+                                     }
+                                 });
+    }
+
+    // the error reported is the first one in the file
+    vector<const char*>::iterator error_it =
+        find_if(errors.begin(),
+                errors.end(),
+                [](const char* msg){return msg != nullptr;});
+    if (error_it != errors.end())
+    {
+        throw Error(*error_it);
+    }
+
+    size_t num_islands = 0, num_ships = 0, num_orders = 0;
+    for_each(pieces.begin(),
+             pieces.end(),
+             [&num_islands, &num_ships, &num_orders](const Scenario& piece)
+             {
+                 num_islands += piece.islands.size();
+                 num_ships += piece.ships.size();
+                 num_orders += piece.orders.size();
+             });
+    islands.reserve(num_islands);
+    ships.reserve(num_ships);
+    orders.reserve(num_orders);
+
+    for_each(pieces.begin(),
+             pieces.end(),
+             [this](Scenario& piece)
+             {
+                 islands.insert(islands.end(),
+                                make_move_iterator(piece.islands.begin()),
+                                make_move_iterator(piece.islands.end()));
+                 ships.insert(ships.end(),
+                              make_move_iterator(piece.ships.begin()),
+                              make_move_iterator(piece.ships.end()));
+                 orders.insert(orders.end(),
+                               make_move_iterator(piece.orders.begin()),
+                               make_move_iterator(piece.orders.end()));
+             });
+
+    check();
+}
+
+void
+Scenario::parse_lines(const char* begin, const char* end)
+{
+    string kind, word;
+
+    while (begin != end)
+    {
+        const char* newline =
+            static_cast<const char*>(memchr(begin, '\n', end - begin));
+        const char* line_end = newline ? newline : end;
+        const char* next = begin;
+        begin = newline ? newline + 1 : end;
+
+        if (!read_word(next, line_end, kind) || kind[0] == '#')
+        {
+            continue;
+        }
+
+        if (kind == "island")
+        {
+            Island_entry island;
+            island.name = read_name(next, line_end);
+            island.location.x = read_double(next, line_end);
+            island.location.y = read_double(next, line_end);
+            island.fuel = 0.;
+            island.production_rate = 0.;
+            if (read_number(next, line_end, island.fuel))
+            {
+                read_number(next, line_end, island.production_rate);
+            }
+            islands.push_back(island);
+        }
+        else if (kind == "ship")
+        {
+            Ship_entry ship;
+            ship.name = read_name(next, line_end);
+            ship.type = read_name(next, line_end);
+            ship.location.x = read_double(next, line_end);
+            ship.location.y = read_double(next, line_end);
+            ships.push_back(ship);
+        }
+        else if (kind == "order")
+        {
+            Order_entry order;
+            order.ship = read_name(next, line_end);
+            order.speed = 0.;
+
+            string command = read_name(next, line_end);
+            if (command == "course")
+            {
+                order.command = Order_entry::COURSE;
+                order.point.x = read_double(next, line_end);
+                if (order.point.x < 0. || order.point.x >= 360.)
+                {
+                    throw Error("Invalid heading entered!");
+                }
+                order.speed = read_speed(next, line_end);
+            }
+            else if (command == "position")
+            {
+                order.command = Order_entry::POSITION;
+                order.point.x = read_double(next, line_end);
+                order.point.y = read_double(next, line_end);
+                order.speed = read_speed(next, line_end);
+            }
+            else if (command == "destination")
+            {
+                order.command = Order_entry::DESTINATION;
+                order.target = read_name(next, line_end);
+                order.speed = read_speed(next, line_end);
+            }
+            else if (command == "load_at")
+            {
+                order.command = Order_entry::LOAD_AT;
+                order.target = read_name(next, line_end);
+            }
+            else if (command == "unload_at")
+            {
+                order.command = Order_entry::UNLOAD_AT;
+                order.target = read_name(next, line_end);
+            }
+            else if (command == "dock_at")
+            {
+                order.command = Order_entry::DOCK_AT;
+                order.target = read_name(next, line_end);
+            }
+            else if (command == "attack")
+            {
+                order.command = Order_entry::ATTACK;
+                order.target = read_name(next, line_end);
+            }
+            else if (command == "refuel")
+            {
+                order.command = Order_entry::REFUEL;
+            }
+            else if (command == "stop")
+            {
+                order.command = Order_entry::STOP;
+            }
+            else if (command == "stop_attack")
+            {
+                order.command = Order_entry::STOP_ATTACK;
+            }
+            else
+            {
+                throw Error("Scenario file is damaged!");
+            }
+            orders.push_back(order);
+        }
+        else
+        {
+            throw Error("Scenario file is damaged!");
+        }
+
+        // nothing may follow the entry
+        if (read_word(next, line_end, word))
+        {
+            throw Error("Scenario file is damaged!");
+        }
+    }
+}
+
+// a name must be as long as for the create command, and no other
+// object may have it; unlike the create command, names may begin with
+// the same two characters, so a scenario is not limited to the number
+// of different pairs of characters that can begin a name
+void
+Scenario::check() const
+{
+    unordered_set<string> island_names, ship_names;
+    island_names.reserve(islands.size());
+    ship_names.reserve(ships.size());
+
+    auto add_name = [&island_names, &ship_names](const string& name,
+                                                 unordered_set<string>& names)
+    {
+        if (name.length() < 2)
+        {
+            throw Error("Name is too short!");
+        }
+        if (island_names.count(name) || ship_names.count(name))
+        {
+            throw Error("Name is already in use!");
+        }
+        names.insert(name);
+    };
+
+    for_each(islands.begin(),
+             islands.end(),
+             [&add_name, &island_names](const Island_entry& island)
+             {add_name(island.name, island_names);});
+    for_each(ships.begin(),
+             ships.end(),
+             [&add_name, &ship_names](const Ship_entry& ship)
+             {add_name(ship.name, ship_names);});
+
+    for_each(orders.begin(),
+             orders.end(),
+             [&island_names, &ship_names](const Order_entry& order)
+             {
+                 if (!ship_names.count(order.ship))
+                 {
+                     throw Error("Ship not found!");
+                 }
+                 switch (order.command)
+                 {
+                     case Order_entry::DESTINATION:
+                     case Order_entry::LOAD_AT:
+                     case Order_entry::UNLOAD_AT:
+                     case Order_entry::DOCK_AT:
+                         if (!island_names.count(order.target))
+                         {
+                             throw Error("Island not found!");
+                         }
+                         break;
+                     case Order_entry::ATTACK:
+                         if (!ship_names.count(order.target))
+                         {
+                             throw Error("Ship not found!");
+                         }
+                         break;
+                     default:
+                         break;
+                 }
+             });
+}
+
+inline void write_bytes(vector<char>& buffer, const void* bytes, size_t size)
+{
+    const char* first = static_cast<const char*>(bytes);
+    buffer.insert(buffer.end(), first, first + size);
+}
+
+inline void write_int(vector<char>& buffer, int32_t value)
+{
+    write_bytes(buffer, &value, sizeof(value));
+}
+
+inline void write_double(vector<char>& buffer, double value)
+{
+    write_bytes(buffer, &value, sizeof(value));
+}
+
+inline void write_string(vector<char>& buffer, const string& value)
+{
+    write_int(buffer, static_cast<int32_t>(value.size()));
+    write_bytes(buffer, value.data(), value.size());
+}
+
+// the counts of islands, ships and orders each come before their entries
+void
+Scenario::write_binary(const string& file_name) const
+{
+    vector<char> buffer;
+    write_bytes(buffer, scenario_magic, sizeof(scenario_magic));
+    write_bytes(buffer, &scenario_version, sizeof(scenario_version));
+
+    write_int(buffer, static_cast<int32_t>(islands.size()));
+    for_each(islands.begin(),
+             islands.end(),
+             [&buffer](const Island_entry& island)
+             {
+                 write_string(buffer, island.name);
+                 write_double(buffer, island.location.x);
+                 write_double(buffer, island.location.y);
+                 write_double(buffer, island.fuel);
+                 write_double(buffer, island.production_rate);
+             });
+
+    write_int(buffer, static_cast<int32_t>(ships.size()));
+    for_each(ships.begin(),
+             ships.end(),
+             [&buffer](const Ship_entry& ship)
+             {
+                 write_string(buffer, ship.name);
+                 write_string(buffer, ship.type);
+                 write_double(buffer, ship.location.x);
+                 write_double(buffer, ship.location.y);
+             });
+
+    write_int(buffer, static_cast<int32_t>(orders.size()));
+    for_each(orders.begin(),
+             orders.end(),
+             [&buffer](const Order_entry& order)
+             {
+                 write_string(buffer, order.ship);
+                 write_int(buffer, order.command);
+                 write_double(buffer, order.point.x);
+                 write_double(buffer, order.point.y);
+                 write_double(buffer, order.speed);
+                 write_string(buffer, order.target);
+             });
+
+    write_bytes(buffer, scenario_magic, sizeof(scenario_magic));
+
+    ofstream file(file_name.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!file || !file.write(&buffer[0], buffer.size()))
+    {
+        throw Error("Could not write scenario file!");
+    }
+}
+
+inline void read_bytes(const vector<char>& buffer,
+                       size_t& position,
+                       size_t end,
+                       void* bytes,
+                       size_t size)
+{
+    if (size > end - position)
+    {
+        throw Error("Scenario file is damaged!");
+    }
+    memcpy(bytes, &buffer[position], size);
+    position += size;
+}
+
+inline int32_t read_int(const vector<char>& buffer, size_t& position, size_t end)
+{
+    int32_t value;
+    read_bytes(buffer, position, end, &value, sizeof(value));
+    return value;
+}
+
+inline double read_double(const vector<char>& buffer, size_t& position, size_t end)
+{
+    double value;
+    read_bytes(buffer, position, end, &value, sizeof(value));
+    return value;
+}
+
+inline string read_string(const vector<char>& buffer, size_t& position, size_t end)
+{
+    int32_t size = read_int(buffer, position, end);
+    if (size < 0 || static_cast<size_t>(size) > end - position)
+    {
+        throw Error("Scenario file is damaged!");
+    }
+    string value(&buffer[position], size);
+    position += size;
+    return value;
+}
+
+// the number of entries read from the file, checked against
+// the smallest size an entry can take
+inline size_t read_count(const vector<char>& buffer,
+                         size_t& position,
+                         size_t end,
+                         size_t min_entry_size)
+{
+    int32_t count = read_int(buffer, position, end);
+    if (count < 0 || static_cast<size_t>(count) > (end - position) / min_entry_size)
+    {
+        throw Error("Scenario file is damaged!");
+    }
+    return static_cast<size_t>(count);
+}
+
+void
+Scenario::read_binary(const vector<char>& buffer)
+{
+    size_t header_size = sizeof(scenario_magic) + sizeof(scenario_version);
+    if (buffer.size() < header_size + sizeof(scenario_magic) ||
+        memcmp(&buffer[buffer.size() - sizeof(scenario_magic)],
+               scenario_magic,
+               sizeof(scenario_magic)))
+    {
+        throw Error("Scenario file is damaged!");
+    }
+
+    uint32_t version;
+    memcpy(&version, &buffer[sizeof(scenario_magic)], sizeof(version));
+    if (version != scenario_version)
+    {
+        throw Error("Unsupported scenario version!");
+    }
+
+    size_t position = header_size;
+    size_t end = buffer.size() - sizeof(scenario_magic);
+
+    islands.clear();
+    ships.clear();
+    orders.clear();
+
+    // an entry takes at least its numbers and the sizes of its strings
+    size_t num_islands = read_count(buffer, position, end, 36);
+    islands.resize(num_islands);
+    for (size_t i = 0; i < num_islands; ++i)
+    {
+        Island_entry& island = islands[i];
+        island.name = read_string(buffer, position, end);
+        island.location.x = read_double(buffer, position, end);
+        island.location.y = read_double(buffer, position, end);
+        island.fuel = read_double(buffer, position, end);
+        island.production_rate = read_double(buffer, position, end);
+    }
+
+    size_t num_ships = read_count(buffer, position, end, 24);
+    ships.resize(num_ships);
+    for (size_t i = 0; i < num_ships; ++i)
+    {
+        Ship_entry& ship = ships[i];
+        ship.name = read_string(buffer, position, end);
+        ship.type = read_string(buffer, position, end);
+        ship.location.x = read_double(buffer, position, end);
+        ship.location.y = read_double(buffer, position, end);
+    }
+
+    size_t num_orders = read_count(buffer, position, end, 36);
+    orders.resize(num_orders);
+    for (size_t i = 0; i < num_orders; ++i)
+    {
+        Order_entry& order = orders[i];
+        order.ship = read_string(buffer, position, end);
+        int32_t command = read_int(buffer, position, end);
+        if (command < Order_entry::COURSE || command > Order_entry::STOP_ATTACK)
+        {
+            throw Error("Scenario file is damaged!");
+        }
+        order.command = static_cast<Order_entry::Command_e>(command);
+        order.point.x = read_double(buffer, position, end);
+        order.point.y = read_double(buffer, position, end);
+        order.speed = read_double(buffer, position, end);
+        order.target = read_string(buffer, position, end);
+    }
+
+    if (position != end)
+    {
+        throw Error("Scenario file is damaged!");
+    }
+
+    check();
+}
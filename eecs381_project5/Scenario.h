@@ -0,0 +1,122 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+/***************************************************************************
+    A Scenario is the description of a world to start a simulation
+    from: its islands, its ships, and the orders the ships are given
+    before the first update. It is read from a text file, or from
+    a binary file holding the same entries, and Model::load replaces
+    every object with those of the scenario.
+
+    A text scenario has one entry per line; blank lines and lines
+    starting with # are ignored:
+        island <name> <x> <y> [<fuel> [<production rate>]]
+        ship <name> <type> <x> <y>
+        order <ship> <command> <arguments>
+    where the command and its arguments are those of a ship command:
+        course <heading> <speed>     position <x> <y> <speed>
+        destination <island> <speed> load_at <island>
+        unload_at <island>           dock_at <island>
+        attack <ship>                refuel
+        stop                         stop_attack
+    Orders are given in the order they are listed, after every
+    island and ship exists.
+    Every name must be different, but unlike names given with the
+    create command, several may begin with the same two characters;
+    the create command still refuses a name whose first two characters
+    begin the name of an object that exists.
+
+    A large text file is cut at line boundaries into pieces that
+    are parsed at the same time by several threads. A binary file
+    starts with a magic number and a version, and ends with the magic
+    number again; it needs no parsing, so it is read in one pass.
+***************************************************************************/
+
+#include "Geometry.h"
+#include <string>
+#include <vector>
+
+class Scenario
+{
+  public:
+      struct Island_entry
+      {
+          std::string name;
+          Point location;
+          double fuel;
+          double production_rate;
+      };
+
+      struct Ship_entry
+      {
+          std::string name;
+          std::string type;
+          Point location;
+      };
+
+      struct Order_entry
+      {
+          enum Command_e
+          {
+              COURSE,
+              POSITION,
+              DESTINATION,
+              LOAD_AT,
+              UNLOAD_AT,
+              DOCK_AT,
+              ATTACK,
+              REFUEL,
+              STOP,
+              STOP_ATTACK
+          };
+
+          std::string ship;
+          Command_e command;
+          // the heading or location, and the speed, if the command has them
+          Point point;
+          double speed;
+          // the island or ship the command refers to, if any
+          std::string target;
+      };
+
+      // read a text or binary scenario file, telling them apart by
+      // the magic number; will throw Error("Could not read scenario file!")
+      // or any of the errors of parse_text and read_binary
+      void read(const std::string& file_name);
+
+      // replace the entries with those of scenario text, and check them;
+      // will throw Error("Scenario file is damaged!") for a malformed
+      // entry, or the error the Controller gives for a bad name, number,
+      // island or ship
+      void parse_text(const std::string&);
+
+      // write the entries as a binary scenario file
+      // will throw Error("Could not write scenario file!")
+      void write_binary(const std::string& file_name) const;
+
+      const std::vector<Island_entry>& get_islands() const
+          {return islands;}
+      const std::vector<Ship_entry>& get_ships() const
+          {return ships;}
+      const std::vector<Order_entry>& get_orders() const
+          {return orders;}
+
+  private:
+      std::vector<Island_entry> islands;
+      std::vector<Ship_entry> ships;
+      std::vector<Order_entry> orders;
+
+      // replace the entries with those of a binary scenario held in memory;
+      // will throw Error("Scenario file is damaged!")
+      // or Error("Unsupported scenario version!")
+      void read_binary(const std::vector<char>&);
+
+      // append the entries of the whole lines in [begin, end)
+      void parse_lines(const char* begin, const char* end);
+
+      // check that names are long enough and unique,
+      // and that orders refer to existing objects
+      void check() const;
+};
+
+#endif
@@ -1,6 +1,9 @@
 #include "Ship.h"
 #include "Model.h"
 #include "Island.h"
+#include "Output.h"
+#include "Checkpoint.h"
+#include "Tick_intents.h"
 #include "Utility.h"
 
 using namespace std;
@@ -12,24 +15,25 @@ Ship::Ship(const string& name_,
            double fuel_consumption_,
            int resistance_) :
     Sim_object(name_),
-    track_base(position_),
-    fuel(fuel_capacity_),
+    slot(Ship_kinematics::get_Instance().allocate(position_,
+                                                  fuel_capacity_,
+                                                  fuel_consumption_)),
     fuel_capacity(fuel_capacity_),
     maximum_speed(maximum_speed_),
-    fuel_consumption(fuel_consumption_),
     resistance(resistance_),
-    docked_island(nullptr),
-    ship_state(STOPPED)
+    docked_island(nullptr)
 {}
 
 Ship::~Ship()
-{}
+{
+    Ship_kinematics::get_Instance().release(slot);
+}
 
 bool
 Ship::can_move() const
 {
     if (!is_afloat() ||
-        ship_state == DEAD_IN_THE_WATER)
+        get_ship_state() == Ship_kinematics::DEAD_IN_THE_WATER)
     {
         return false;
     } 
@@ -39,8 +43,8 @@ Ship::can_move() const
 bool
 Ship::is_moving() const
 {
-    if (ship_state == MOVING_TO_POSITION ||
-        ship_state == MOVING_ON_COURSE)
+    if (get_ship_state() == Ship_kinematics::MOVING_TO_POSITION ||
+        get_ship_state() == Ship_kinematics::MOVING_ON_COURSE)
     {
         return true;
     }
@@ -50,7 +54,7 @@ Ship::is_moving() const
 bool
 Ship::is_docked() const
 {
-    if (ship_state == DOCKED)
+    if (get_ship_state() == Ship_kinematics::DOCKED)
     {
         return true;
     }
@@ -60,7 +64,7 @@ Ship::is_docked() const
 bool
 Ship::is_afloat() const
 {
-    if (ship_state == SUNK)
+    if (get_ship_state() == Ship_kinematics::SUNK)
     {
         return false;
     }
@@ -70,7 +74,7 @@ Ship::is_afloat() const
 bool
 Ship::can_dock(shared_ptr<Island> island_ptr) const
 {
-    if (ship_state == STOPPED &&
+    if (get_ship_state() == Ship_kinematics::STOPPED &&
         cartesian_distance(island_ptr->get_location(),
                            get_location()) <= 0.1)
 
@@ -84,41 +88,46 @@ Ship::can_dock(shared_ptr<Island> island_ptr) const
 void
 Ship::update()
 {
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+
     // ship is still afloat
     if (is_afloat())
     {
         if (resistance < 0)
         {
-            ship_state = SUNK;
-            track_base.set_speed(0.0);
-            cout << get_name() << " sunk" << endl;
-            Model::get_Instance().notify_gone(get_name());
+            set_ship_state(Ship_kinematics::SUNK);
+            kinematics.set_speed(slot, 0.0);
+            Output::get_Instance().write(Output_sink::SHIP_SUNK, get_id());
+            Model::get_Instance().notify_gone(get_id());
+            Model::get_Instance().add_sunk_ship(get_id());
         }
         else
         {
-            switch (ship_state)
+            switch (get_ship_state())
             {
-                case MOVING_TO_POSITION:
-                case MOVING_ON_COURSE:
+                case Ship_kinematics::MOVING_TO_POSITION:
+                case Ship_kinematics::MOVING_ON_COURSE:
                     calculate_movement();
-                    cout << get_name() << " now at "
-                         << track_base.get_position() << endl;
-                    Model::get_Instance().notify_location(get_name(),
-                                                          track_base.
-                                                              get_position());
-                    Model::get_Instance().notify_fuel(get_name(), fuel);
-                    break;
-                case DOCKED:
-                    cout << get_name() << " docked at "
-                         << get_docked_Island()->get_name() << endl;
+                    Output::get_Instance().write(Output_sink::SHIP_NOW_AT,
+                                                 get_id(),
+                                                 kinematics.get_position(slot));
+                    Model::get_Instance().notify_location(get_id(),
+                                                          kinematics.
+                                                              get_position(slot));
+                    Model::get_Instance().notify_fuel(get_id(),
+                                                      kinematics.get_fuel(slot));
+
+                    // the ship stops on arriving or running out of fuel
+                    if (!is_moving())
+                    {
+                        Model::get_Instance().notify_state(get_id(),
+                                                           get_ship_state());
+                    }
                     break;
-                case STOPPED:
-                    cout << get_name() << " stopped at "
-                         << track_base.get_position() << endl;
-                    break;
-                case DEAD_IN_THE_WATER:
-                    cout << get_name() << " dead in the water at "
-                         << track_base.get_position() << endl;
+                case Ship_kinematics::DOCKED:
+                case Ship_kinematics::STOPPED:
+                case Ship_kinematics::DEAD_IN_THE_WATER:
+                    output_status();
                     break;
                 default:
                     break;
@@ -127,11 +136,77 @@ Ship::update()
     }
 }
 
+bool
+Ship::is_dormant() const
+{
+    switch (get_ship_state())
+    {
+        case Ship_kinematics::DOCKED:
+        case Ship_kinematics::STOPPED:
+        case Ship_kinematics::DEAD_IN_THE_WATER:
+            return (resistance >= 0);
+        default:
+            return false;
+    }
+}
+
+int
+Ship::get_quiet_updates() const
+{
+    if (!is_afloat() || resistance < 0)
+    {
+        return 0;
+    }
+    return Ship_kinematics::get_Instance().get_quiet_ticks(slot);
+}
+
+void
+Ship::skip_updates(int num_updates)
+{
+    if (!is_moving())
+    {
+        return;
+    }
+
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+    kinematics.advance(slot, num_updates);
+    Model::get_Instance().notify_location(get_id(),
+                                          kinematics.get_position(slot));
+    Model::get_Instance().notify_fuel(get_id(), kinematics.get_fuel(slot));
+}
+
+void
+Ship::output_status() const
+{
+    switch (get_ship_state())
+    {
+        case Ship_kinematics::DOCKED:
+            Output::get_Instance().write(Output_sink::SHIP_DOCKED_AT,
+                                         get_id(),
+                                         get_docked_Island()->get_id());
+            break;
+        case Ship_kinematics::STOPPED:
+            Output::get_Instance().write(Output_sink::SHIP_STOPPED_AT,
+                                         get_id(),
+                                         get_location());
+            break;
+        case Ship_kinematics::DEAD_IN_THE_WATER:
+            Output::get_Instance().write(Output_sink::SHIP_DEAD_AT,
+                                         get_id(),
+                                         get_location());
+            break;
+        default:
+            break;
+    }
+}
+
 void
 Ship::describe() const
 {
+    const Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+
     // output ship's name and position
-    cout << get_name() << " at " << track_base.get_position();
+    cout << get_name() << " at " << kinematics.get_position(slot);
 
     // output for ship that is not afloat
     if (!is_afloat())
@@ -141,26 +216,26 @@ Ship::describe() const
     // output for ship that is afloat
     else
     {
-        cout << ", fuel: " << fuel << " tons"
+        cout << ", fuel: " << kinematics.get_fuel(slot) << " tons"
              << ", resistance: " << resistance << endl;
 
-        switch (ship_state)
+        switch (get_ship_state())
         {
-            case MOVING_TO_POSITION:
-                cout << "Moving to " << destination
-                     << " on " << track_base.get_course_speed() << endl;
+            case Ship_kinematics::MOVING_TO_POSITION:
+                cout << "Moving to " << kinematics.get_destination(slot)
+                     << " on " << kinematics.get_course_speed(slot) << endl;
                 break;
-            case MOVING_ON_COURSE:
-              cout << "Moving on " << track_base.get_course_speed() << endl;
+            case Ship_kinematics::MOVING_ON_COURSE:
+              cout << "Moving on " << kinematics.get_course_speed(slot) << endl;
                 break;
-            case DOCKED:
+            case Ship_kinematics::DOCKED:
                 cout << "Docked at " << get_docked_Island()->get_name()
                      << endl;
                 break;
-            case STOPPED:
+            case Ship_kinematics::STOPPED:
                 cout << "Stopped" << endl;
                 break;
-            case DEAD_IN_THE_WATER:
+            case Ship_kinematics::DEAD_IN_THE_WATER:
                 cout << "Dead in the water" << endl;
                 break;
             default:
@@ -169,48 +244,95 @@ Ship::describe() const
     }
 }
 
+void
+Ship::save_state(Checkpoint_writer& writer) const
+{
+    const Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+    writer.write_point(kinematics.get_position(slot));
+    writer.write_double(kinematics.get_course(slot));
+    writer.write_double(kinematics.get_speed(slot));
+    writer.write_double(kinematics.get_fuel(slot));
+    writer.write_point(kinematics.get_destination(slot));
+    writer.write_int(kinematics.get_state(slot));
+    writer.write_int(resistance);
+    writer.write_island(docked_island);
+}
+
+// the state is set in the store directly,
+// since the views are given the restored objects afterwards
+void
+Ship::restore_state(Checkpoint_reader& reader)
+{
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+    kinematics.set_position(slot, reader.read_point());
+    kinematics.set_course(slot, reader.read_double());
+    kinematics.set_speed(slot, reader.read_double());
+    kinematics.set_fuel(slot, reader.read_double());
+    kinematics.set_destination(slot, reader.read_point());
+
+    int32_t state = reader.read_int();
+    if (state < Ship_kinematics::DOCKED || state > Ship_kinematics::SUNK)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    kinematics.set_state(slot, static_cast<Ship_kinematics::State_e>(state));
+
+    resistance    = reader.read_int();
+    docked_island = reader.read_island();
+}
+
 void
 Ship::broadcast_current_state()
 {
-    Model::get_Instance().notify_location(get_name(), get_location());
-    Model::get_Instance().notify_fuel(get_name(), fuel);
-    Model::get_Instance().notify_speed(get_name(), track_base.get_speed());
-    Model::get_Instance().notify_course(get_name(), track_base.get_course());
+    const Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+
+    Model::get_Instance().notify_location(get_id(), get_location());
+    Model::get_Instance().notify_fuel(get_id(), kinematics.get_fuel(slot));
+    Model::get_Instance().notify_speed(get_id(), kinematics.get_speed(slot));
+    Model::get_Instance().notify_course(get_id(), kinematics.get_course(slot));
+    Model::get_Instance().notify_state(get_id(), get_ship_state());
 }
 
 void
 Ship::set_destination_position_and_speed(Point destination_position,
                                          double speed)
 {
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+
     check_speed_and_move(speed);
     Compass_vector compass_vector(get_location(), destination_position);
-    track_base.set_course(compass_vector.direction);
-    track_base.set_speed(speed);
-    destination = destination_position;
-    ship_state  = MOVING_TO_POSITION;
+    kinematics.set_course(slot, compass_vector.direction);
+    kinematics.set_speed(slot, speed);
+    kinematics.set_destination(slot, destination_position);
+    set_ship_state(Ship_kinematics::MOVING_TO_POSITION);
     
     // notify view of changes to speed and course
-    Model::get_Instance().notify_speed(get_name(), speed);
-    Model::get_Instance().notify_course(get_name(), compass_vector.direction);
+    Model::get_Instance().notify_speed(get_id(), speed);
+    Model::get_Instance().notify_course(get_id(), compass_vector.direction);
     
-    cout << get_name() << " will sail on "
-         << track_base.get_course_speed() << " to " << destination << endl;
+    Output::get_Instance().write(Output_sink::SHIP_WILL_SAIL_TO,
+                                 get_id(),
+                                 kinematics.get_course_speed(slot),
+                                 destination_position);
 }
 
 void
 Ship::set_course_and_speed(double course, double speed)
 {
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+
     check_speed_and_move(speed);
-    track_base.set_course(course);
-    track_base.set_speed(speed);
-    ship_state = MOVING_ON_COURSE;
+    kinematics.set_course(slot, course);
+    kinematics.set_speed(slot, speed);
+    set_ship_state(Ship_kinematics::MOVING_ON_COURSE);
     
     // notify view of changes to speed and course
-    Model::get_Instance().notify_speed(get_name(), speed);
-    Model::get_Instance().notify_course(get_name(), course);
+    Model::get_Instance().notify_speed(get_id(), speed);
+    Model::get_Instance().notify_course(get_id(), course);
     
-    cout << get_name() << " will sail on "
-         << track_base.get_course_speed() << endl;
+    Output::get_Instance().write(Output_sink::SHIP_WILL_SAIL,
+                                 get_id(),
+                                 kinematics.get_course_speed(slot));
 }
 
 void
@@ -220,13 +342,15 @@ Ship::stop()
     {
         throw Error("Ship cannot move!");
     }
-    track_base.set_speed(0.0);
-    ship_state = STOPPED;
+    Ship_kinematics::get_Instance().set_speed(slot, 0.0);
+    set_ship_state(Ship_kinematics::STOPPED);
     
     // notify view of changes to speed
-    Model::get_Instance().notify_speed(get_name(), 0.0);
+    Model::get_Instance().notify_speed(get_id(), 0.0);
     
-    cout << get_name() << " stopping at " << get_location() << endl;
+    Output::get_Instance().write(Output_sink::SHIP_STOPPING_AT,
+                                 get_id(),
+                                 get_location());
 }
 
 void
@@ -236,14 +360,17 @@ Ship::dock(shared_ptr<Island> island_ptr)
     {
         throw Error("Can't dock!");
     }
-    track_base.set_position(island_ptr->get_location());
+    Ship_kinematics::get_Instance().set_position(slot,
+                                                 island_ptr->get_location());
     docked_island = island_ptr;
-    ship_state    = DOCKED;
+    set_ship_state(Ship_kinematics::DOCKED);
     
     // notify view of change to location
-    Model::get_Instance().notify_location(get_name(), get_location());
+    Model::get_Instance().notify_location(get_id(), get_location());
     
-    cout << get_name() << " docked at " << island_ptr->get_name() << endl;
+    Output::get_Instance().write(Output_sink::SHIP_DOCKS_AT,
+                                 get_id(),
+                                 island_ptr->get_id());
 }
 
 void
@@ -253,6 +380,14 @@ Ship::refuel()
     {
         throw Error("Must be docked!");
     }
+    Tick_intents::carry_out(Tick_intents::FUEL_TRANSFER, [this]{take_fuel();});
+}
+
+void
+Ship::take_fuel()
+{
+    Ship_kinematics& kinematics = Ship_kinematics::get_Instance();
+    double fuel = kinematics.get_fuel(slot);
     double fuel_needed_to_fill = fuel_capacity - fuel;
     if (fuel_needed_to_fill < 0.005)
     {
@@ -261,11 +396,12 @@ Ship::refuel()
     else
     {
         fuel += get_docked_Island()->provide_fuel(fuel_needed_to_fill);
-        cout << get_name() << " now has " << fuel << " tons of fuel" << endl;
+        Output::get_Instance().write(Output_sink::SHIP_REFUELED, get_id(), fuel);
     }
+    kinematics.set_fuel(slot, fuel);
     
     // notify view of changes to fuel
-    Model::get_Instance().notify_fuel(get_name(), fuel);
+    Model::get_Instance().notify_fuel(get_id(), fuel);
 }
 
 void
@@ -296,101 +432,36 @@ void
 Ship::receive_hit(int hit_force, shared_ptr<Ship> attacker_ptr)
 {
     resistance -= hit_force;
-    cout << get_name() << " hit with "
-         << hit_force << ", resistance now "
-         << resistance << endl;
+
+    // the hit may sink this ship, so it must be updated
+    Model::get_Instance().wake(get_id());
+
+    Output::get_Instance().write(Output_sink::SHIP_HIT,
+                                 get_id(),
+                                 double(hit_force),
+                                 double(resistance));
 }
 
 // Calculate the new position of a ship based on
 // how it is moving, its speed, and
 // fuel state. This function should be
-// called only if the state is 
+// called only if the state is
 // MOVING_TO_POSITION or MOVING_ON_COURSE.
 //
-// Track_base has an update_position(double time)
-// function that computes the new position
-// of an object after the specified time has elapsed.
-// If the Ship is going to move
-// for a full time unit (one hour), then it will
-// get go the "full step" distance,
-// so update_position would be called with
-// time = 1.0. If we can move less than that,
-// e.g. due to not enough fuel, update position
-// will be called with the corresponding
-// time less than 1.0.
-//
-// For clarity in specifying the computation,
-// this code assumes the specified private variable names, 
-// but you may change the variable names or
-// state names if you wish (e.g. movement_state).
+// The movement of every moving ship is computed together
+// by Ship_kinematics at the start of the tick;
+// here the ship takes its own result as its current state.
 void
 Ship::calculate_movement()
 {
-    // Compute values for how much we need to move,
-    // and how much we can, and how long we can,
-    // given the fuel state, then decide what to do.
-
-    // full step time
-    double time = 1.0;
-
-    // get the distance to destination
-    double destination_distance = cartesian_distance(get_location(),
-                                                     destination);
-
-    // get full step distance we can move on this time step
-    double full_distance = track_base.get_speed() * time;
-
-    // get fuel required for full step distance
-    double full_fuel_required = full_distance * fuel_consumption;
-
-    // how far and how long can we sail
-    // in this time period based on the fuel state?
-    double distance_possible, time_possible;
-
-    if (full_fuel_required <= fuel)
-    {
-        distance_possible = full_distance;
-        time_possible = time;
-    }
-    else
-    {
-        // nm = tons / tons/nm
-        distance_possible = fuel / fuel_consumption;
-        time_possible = (distance_possible / full_distance) * time;
-    }
-
-    // are we moving to a destination,
-    // and is the destination within the distance possible?
-    if (ship_state == MOVING_TO_POSITION &&
-        destination_distance <= distance_possible)
-    {
-        // yes, make our new position the destination
-        track_base.set_position(destination);
-
-        // we travel the destination distance, using that much fuel
-        double fuel_required = destination_distance * fuel_consumption;
-        fuel -= fuel_required;
-        track_base.set_speed(0.0);
-        ship_state = STOPPED;
-    }
-    else
-    {
-        // go as far as we can, stay in the same movement state
-        // simply move for the amount of time possible
-        track_base.update_position(time_possible);
+    Ship_kinematics::get_Instance().calculate_movement(slot);
+}
 
-        // have we used up our fuel?
-        if (full_fuel_required >= fuel)
-        {
-            fuel = 0.0;
-            track_base.set_speed(0.0);
-            ship_state = DEAD_IN_THE_WATER;
-        }
-        else
-        {
-            fuel -= full_fuel_required;
-        }
-    }
+void
+Ship::set_ship_state(Ship_kinematics::State_e ship_state)
+{
+    Ship_kinematics::get_Instance().set_state(slot, ship_state);
+    Model::get_Instance().notify_state(get_id(), ship_state);
 }
 
 void
@@ -10,9 +10,11 @@
     while moving, and becomes immobile
     if it runs out of fuel. It inherits the Sim_object 
     interface to the rest of the system,
-    and the Track_base class provides the basic movement 
+    and the Ship_kinematics store keeps its position, course, speed,
+    fuel and movement state and provides the basic movement
     functionality, with the unit of time
     corresponding to 1.0 for one "tick" - an hour of simulated time.
+    A Ship only keeps the slot of its row in that store.
 
     The update function updates the position and/or state of the ship.
     The describe function outputs information about the ship state.
@@ -24,7 +26,7 @@
 ***************************************************************************/
 
 #include "Sim_object.h"
-#include "Track_base.h"
+#include "Ship_kinematics.h"
 #include <string>
 #include <memory>
 
@@ -54,7 +56,7 @@ class Ship : public Sim_object
 
       // return the current position
       Point get_location() const override
-          {return track_base.get_position();}
+          {return Ship_kinematics::get_Instance().get_position(slot);}
 
       // Return true if ship can move
       // (it is not dead in the water or in the process or sinking); 
@@ -76,9 +78,29 @@ class Ship : public Sim_object
       // Update the state of the Ship
       void update() override;
 
+      // a Ship that is afloat and not moving is dormant
+      // unless it is about to sink
+      bool is_dormant() const override;
+
+      // output the status line of a Ship that is not moving,
+      // which is all that its update does
+      void output_status() const;
+
+      // a moving Ship is quiet until it is about to arrive
+      // or run out of fuel, and a stopped one stays quiet
+      int get_quiet_updates() const override;
+      void skip_updates(int) override;
+
       // output a description of current state to cout
       void describe() const override;
 
+      // the type of Ship, as given to create_ship
+      virtual const char* get_type_name() const = 0;
+
+      // the movement state, resistance, and Island docked at
+      void save_state(Checkpoint_writer&) const override;
+      void restore_state(Checkpoint_reader&) override;
+
       void broadcast_current_state() override;
 
       // Start moving to a destination position at a speed
@@ -103,6 +125,7 @@ class Ship : public Sim_object
       // Refuel - must already be docked at an island;
       // fill takes as much as possible
       // may throw Error("Must be docked!");
+      // During an update, the fuel is taken as a FUEL_TRANSFER step.
       virtual void refuel();
 
       // These functions throw an Error exception for this class
@@ -124,7 +147,7 @@ class Ship : public Sim_object
     
       // return heading of the ship
       double get_heading()
-          {return track_base.get_course();}
+          {return Ship_kinematics::get_Instance().get_course(slot);}
     
   protected:
       double get_maximum_speed() const
@@ -136,29 +159,25 @@ class Ship : public Sim_object
           {return docked_island;}
 
   private:
-      Track_base track_base;
-      double fuel;
+      int slot;   // row of this ship in Ship_kinematics
       double fuel_capacity;
       double maximum_speed;
-      double fuel_consumption;
       int resistance;
-      Point destination;
       std::shared_ptr<Island> docked_island;
 
-      enum Ship_State_e
-      {
-          DOCKED,
-          STOPPED,
-          MOVING_TO_POSITION,
-          MOVING_ON_COURSE,
-          DEAD_IN_THE_WATER,
-          SUNK
-      } ship_state;
+      // accessors for the movement state kept in Ship_kinematics
+      Ship_kinematics::State_e get_ship_state() const
+          {return Ship_kinematics::get_Instance().get_state(slot);}
+      // the views are notified of the new state
+      void set_ship_state(Ship_kinematics::State_e);
 
       // Updates position, fuel, and movement_state,
       // assuming 1 time unit (1 hr)
       void calculate_movement();
 
+      // fill up from the Island docked at, as far as its fuel goes
+      void take_fuel();
+
       // makes a check on the following:
       // 1) can ship move?
       // 2) is ship's speed fast enough?
@@ -0,0 +1,206 @@
+#include "Ship_kinematics.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace std;
+
+Ship_kinematics&
+Ship_kinematics::get_Instance()
+{
+    static Ship_kinematics ship_kinematics;
+    return ship_kinematics;
+}
+
+Ship_kinematics::Ship_kinematics()
+{}
+
+Ship_kinematics::~Ship_kinematics()
+{}
+
+int
+Ship_kinematics::allocate(Point position,
+                          double fuel_,
+                          double fuel_consumption_)
+{
+    int slot;
+
+    // reuse a row given back by a destroyed ship
+    if (!free_slots.empty())
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    // otherwise, grow every column by one row
+    else
+    {
+        slot = static_cast<int>(x.size());
+        x.push_back(0.);
+        y.push_back(0.);
+        course.push_back(0.);
+        speed.push_back(0.);
+        fuel.push_back(0.);
+        fuel_consumption.push_back(0.);
+        destination_x.push_back(0.);
+        destination_y.push_back(0.);
+        state.push_back(SUNK);
+    }
+
+    x[slot]                = position.x;
+    y[slot]                = position.y;
+    course[slot]           = 0.;
+    speed[slot]            = 0.;
+    fuel[slot]             = fuel_;
+    fuel_consumption[slot] = fuel_consumption_;
+    destination_x[slot]    = 0.;
+    destination_y[slot]    = 0.;
+    state[slot]            = STOPPED;
+
+    return slot;
+}
+
+void
+Ship_kinematics::release(int slot)
+{
+    state[slot] = SUNK;
+    free_slots.push_back(slot);
+}
+
+// ticks kept out of a quiet stretch before an arrival or running out
+// of fuel, so that rounding in the closed form cannot step past it
+const double quiet_margin = 2.;
+
+// Calculate the new position of a ship based on
+// how it is moving, its speed, and fuel state,
+// assuming 1 time unit (1 hr).
+// This function should be called only if the state is
+// MOVING_TO_POSITION or MOVING_ON_COURSE.
+//
+// If the ship is going to move for a full time unit,
+// then it will go the "full step" distance.
+// If it can move less than that, e.g. due to not enough fuel,
+// it moves for the corresponding time less than 1.0.
+void
+Ship_kinematics::calculate_movement(int slot)
+{
+    // full step time
+    double time = 1.0;
+
+    Point position(x[slot], y[slot]);
+
+    // get the distance to destination
+    double destination_distance =
+        cartesian_distance(position,
+                           Point(destination_x[slot], destination_y[slot]));
+
+    // get full step distance we can move on this time step
+    double full_distance = speed[slot] * time;
+
+    // get fuel required for full step distance
+    double full_fuel_required = full_distance * fuel_consumption[slot];
+
+    // how far and how long can we sail
+    // in this time period based on the fuel state?
+    double distance_possible, time_possible;
+
+    if (full_fuel_required <= fuel[slot])
+    {
+        distance_possible = full_distance;
+        time_possible = time;
+    }
+    else
+    {
+        // nm = tons / tons/nm
+        distance_possible = fuel[slot] / fuel_consumption[slot];
+        time_possible = (distance_possible / full_distance) * time;
+    }
+
+    // are we moving to a destination,
+    // and is the destination within the distance possible?
+    if (state[slot] == MOVING_TO_POSITION &&
+        destination_distance <= distance_possible)
+    {
+        // yes, make our new position the destination
+        // and use the fuel for the destination distance
+        x[slot]     = destination_x[slot];
+        y[slot]     = destination_y[slot];
+        fuel[slot] -= destination_distance * fuel_consumption[slot];
+        speed[slot] = 0.0;
+        state[slot] = STOPPED;
+    }
+    else
+    {
+        // go as far as we can, stay in the same movement state
+        // simply move for the amount of time possible
+        position = position + Course_speed(course[slot], speed[slot]) *
+                              time_possible;
+        x[slot] = position.x;
+        y[slot] = position.y;
+
+        // have we used up our fuel?
+        if (full_fuel_required >= fuel[slot])
+        {
+            fuel[slot]  = 0.0;
+            speed[slot] = 0.0;
+            state[slot] = DEAD_IN_THE_WATER;
+        }
+        else
+        {
+            fuel[slot] -= full_fuel_required;
+        }
+    }
+}
+
+// A tick is quiet if the ship has more fuel than a full step needs,
+// and when moving to a position, is more than a full step away;
+// both the fuel and the distance go down by the same amount
+// every quiet tick, so the number of them is a quotient.
+int
+Ship_kinematics::get_quiet_ticks(int slot) const
+{
+    if (state[slot] != MOVING_TO_POSITION &&
+        state[slot] != MOVING_ON_COURSE)
+    {
+        return numeric_limits<int>::max();
+    }
+
+    double full_distance      = speed[slot];
+    double full_fuel_required = full_distance * fuel_consumption[slot];
+    double quiet_ticks        = numeric_limits<int>::max();
+
+    if (full_fuel_required > 0.)
+    {
+        quiet_ticks = min(quiet_ticks, fuel[slot] / full_fuel_required);
+    }
+    else if (fuel[slot] <= 0.)
+    {
+        return 0;
+    }
+
+    if (state[slot] == MOVING_TO_POSITION)
+    {
+        double destination_distance =
+            cartesian_distance(get_position(slot), get_destination(slot));
+        if (full_distance > 0.)
+        {
+            quiet_ticks = min(quiet_ticks,
+                              destination_distance / full_distance);
+        }
+        else if (destination_distance <= 0.)
+        {
+            return 0;
+        }
+    }
+
+    return static_cast<int>(max(floor(quiet_ticks - quiet_margin), 0.));
+}
+
+void
+Ship_kinematics::advance(int slot, int num_ticks)
+{
+    Point position = get_position(slot) +
+                     get_course_speed(slot) * double(num_ticks);
+    x[slot]     = position.x;
+    y[slot]     = position.y;
+    fuel[slot] -= speed[slot] * fuel_consumption[slot] * num_ticks;
+}
@@ -0,0 +1,112 @@
+#ifndef SHIP_KINEMATICS_H
+#define SHIP_KINEMATICS_H
+
+/***************************************************************************
+    Ship_kinematics is a store for the movement state of every Ship.
+    Instead of each Ship keeping its own position, course, speed,
+    fuel and state, the values are kept in parallel arrays,
+    one row per Ship, so that the movement of the whole fleet
+    can be computed over contiguous memory.
+    A Ship only keeps the index of its row (a "slot").
+    Each row is moved only from its own values, so the rows of
+    different ships can be moved on different threads at once,
+    as the Model does when it computes the updates of a tick.
+***************************************************************************/
+
+#include "Geometry.h"
+#include "Navigation.h"
+#include <vector>
+
+class Ship_kinematics
+{
+  public:
+      // states of a ship's movement
+      enum State_e
+      {
+          DOCKED,
+          STOPPED,
+          MOVING_TO_POSITION,
+          MOVING_ON_COURSE,
+          DEAD_IN_THE_WATER,
+          SUNK
+      };
+
+      // force Ship_kinematics as a singleton object
+      static Ship_kinematics& get_Instance();
+
+      // forbid copy/move, construction/assignment
+      Ship_kinematics(const Ship_kinematics&) = delete;
+      Ship_kinematics(Ship_kinematics&&) = delete;
+      Ship_kinematics& operator= (const Ship_kinematics&) = delete;
+      Ship_kinematics& operator= (Ship_kinematics&&) = delete;
+
+      // reserve a row for a new stopped ship, and return its slot
+      int allocate(Point position, double fuel, double fuel_consumption);
+
+      // give back a row when its ship is destroyed
+      void release(int slot);
+
+      // Readers
+      Point get_position(int slot) const
+          {return Point(x[slot], y[slot]);}
+      double get_course(int slot) const
+          {return course[slot];}
+      double get_speed(int slot) const
+          {return speed[slot];}
+      Course_speed get_course_speed(int slot) const
+          {return Course_speed(course[slot], speed[slot]);}
+      double get_fuel(int slot) const
+          {return fuel[slot];}
+      Point get_destination(int slot) const
+          {return Point(destination_x[slot], destination_y[slot]);}
+      State_e get_state(int slot) const
+          {return state[slot];}
+
+      // Writers
+      void set_position(int slot, Point position)
+          {x[slot] = position.x; y[slot] = position.y;}
+      void set_course(int slot, double course_)
+          {course[slot] = course_;}
+      void set_speed(int slot, double speed_)
+          {speed[slot] = speed_;}
+      void set_fuel(int slot, double fuel_)
+          {fuel[slot] = fuel_;}
+      void set_destination(int slot, Point destination)
+          {destination_x[slot] = destination.x;
+           destination_y[slot] = destination.y;}
+      void set_state(int slot, State_e state_)
+          {state[slot] = state_;}
+
+      // move the ship for one time unit (1 hr);
+      // it must be moving
+      void calculate_movement(int slot);
+
+      // number of the coming ticks in which the ship will certainly
+      // neither arrive nor run out of fuel, so that its movement
+      // over them is a straight line at constant speed;
+      // a ship that is not moving is never limited
+      int get_quiet_ticks(int slot) const;
+
+      // move the ship for that many quiet ticks at once
+      void advance(int slot, int num_ticks);
+
+  private:
+      Ship_kinematics();
+      ~Ship_kinematics();
+
+      // current values of each row
+      std::vector<double> x;
+      std::vector<double> y;
+      std::vector<double> course;
+      std::vector<double> speed;
+      std::vector<double> fuel;
+      std::vector<double> fuel_consumption;
+      std::vector<double> destination_x;
+      std::vector<double> destination_y;
+      std::vector<State_e> state;
+
+      // rows given back by destroyed ships
+      std::vector<int> free_slots;
+};
+
+#endif
@@ -4,7 +4,8 @@
 /*************************************************
     This class provides the interface for all of
     simulation objects. It also stores the
-    object's name, and has pure virtual accessor
+    object's id in the Name_table, from which its
+    name can be obtained, and has pure virtual accessor
     functions for the object's position
     and other information.
 *************************************************/
@@ -12,19 +13,27 @@
 #include <string>
 #include <iostream>
 #include "Geometry.h"
+#include "Name_table.h"
+
+class Checkpoint_writer;
+class Checkpoint_reader;
 
 class Sim_object
 {
   public:
       Sim_object(const std::string& name_) : 
-          name(name_)
+          id(Name_table::get_Instance().intern(name_))
           {}
 
       virtual ~Sim_object()
           {}
 
       const std::string& get_name() const
-          {return name;}
+          {return Name_table::get_Instance().get_name(id);}
+
+      // the id of the object's name
+      int get_id() const
+          {return id;}
 
       // ask model to notify views of current state
       virtual void broadcast_current_state() {}
@@ -37,9 +46,36 @@ class Sim_object
 
       // pure virtual function for updating an object
       virtual void update() = 0;
+
+      // return true if updating the object would do nothing
+      // but output its status, and would keep doing so until
+      // something else changes it; Model stops updating it until then
+      virtual bool is_dormant() const
+          {return false;}
+
+      // return the id of the object that its next update may change,
+      // or -1 if none; Model does not compute that object's update
+      // ahead of the others, since it may change before its turn
+      virtual int get_target_id() const
+          {return -1;}
+
+      // return how many of the coming updates would only continue
+      // the object's steady change, with nothing else happening;
+      // Model can then make them all at once with skip_updates
+      virtual int get_quiet_updates() const
+          {return 0;}
+
+      // make the changes of that many quiet updates, without output
+      virtual void skip_updates(int) {}
+
+      // write the state that the constructor does not give the object
+      // to a checkpoint, and read it back into a newly made object;
+      // a derived class saves its base class's state first
+      virtual void save_state(Checkpoint_writer&) const {}
+      virtual void restore_state(Checkpoint_reader&) {}
         
   private:
-      std::string name;
+      int id;
 };
 
 #endif
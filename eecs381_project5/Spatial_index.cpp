@@ -0,0 +1,179 @@
+#include "Spatial_index.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// cell indices are kept well inside the range of the 32-bit halves of a key
+const double max_cell_index = 1.e9;
+
+Spatial_index::Spatial_index(double cell_size_) :
+    cell_size(cell_size_),
+    num_objects(0)
+{}
+
+void
+Spatial_index::insert(int id, Point location)
+{
+    if (id >= static_cast<int>(present.size()))
+    {
+        locations.resize(id + 1);
+        present.resize(id + 1, 0);
+    }
+
+    locations[id] = location;
+    present[id]   = 1;
+    ++num_objects;
+
+    cells[get_cell_key(get_cell_index(location.x),
+                       get_cell_index(location.y))].push_back(id);
+}
+
+void
+Spatial_index::remove(int id)
+{
+    if (!contains(id))
+    {
+        return;
+    }
+
+    remove_from_cell(id);
+    present[id] = 0;
+    --num_objects;
+}
+
+void
+Spatial_index::move(int id, Point location)
+{
+    Point& old_location = locations[id];
+
+    // only change cells if the object has left its cell
+    if (get_cell_index(old_location.x) != get_cell_index(location.x) ||
+        get_cell_index(old_location.y) != get_cell_index(location.y))
+    {
+        remove_from_cell(id);
+        cells[get_cell_key(get_cell_index(location.x),
+                           get_cell_index(location.y))].push_back(id);
+    }
+
+    old_location = location;
+}
+
+void
+Spatial_index::find_at(Point location, vector<int>& result) const
+{
+    unordered_map<Cell_key, vector<int>>::const_iterator it =
+        cells.find(get_cell_key(get_cell_index(location.x),
+                                get_cell_index(location.y)));
+    if (it == cells.end())
+    {
+        return;
+    }
+
+    for_each(it->second.begin(),
+             it->second.end(),
+             [this, &location, &result](int id)
+             {
+                 if (locations[id] == location)
+                 {
+                     result.push_back(id);
+                 }
+             });
+}
+
+void
+Spatial_index::find_within(Point center,
+                           double radius,
+                           vector<int>& result) const
+{
+    // append the ids in a cell that are within the radius
+    auto search_cell = [this, &center, radius, &result](const vector<int>& ids)
+    {
+        for_each(ids.begin(),
+                 ids.end(),
+                 [this, &center, radius, &result](int id)
+                 {
+                     if (cartesian_distance(center, locations[id]) <= radius)
+                     {
+                         result.push_back(id);
+                     }
+                 });
+    };
+
+    long long first_column = get_cell_index(center.x - radius);
+    long long last_column  = get_cell_index(center.x + radius);
+    long long first_row    = get_cell_index(center.y - radius);
+    long long last_row     = get_cell_index(center.y + radius);
+
+    // if the square around the circle covers more cells than exist,
+    // it is quicker to look at every cell that exists
+    double num_covered = double(last_column - first_column + 1) *
+                         double(last_row - first_row + 1);
+    if (num_covered > cells.size())
+    {
+        for_each(cells.begin(),
+                 cells.end(),
+                 [&search_cell](const pair<const Cell_key, vector<int>>& cell)
+                 {search_cell(cell.second);});
+        return;
+    }
+
+    for (long long column = first_column; column <= last_column; ++column)
+    {
+        for (long long row = first_row; row <= last_row; ++row)
+        {
+            unordered_map<Cell_key, vector<int>>::const_iterator it =
+                cells.find(get_cell_key(column, row));
+            if (it != cells.end())
+            {
+                search_cell(it->second);
+            }
+        }
+    }
+}
+
+long long
+Spatial_index::get_cell_index(double coordinate) const
+{
+    double index = floor(coordinate / cell_size);
+
+    // keep far away or invalid coordinates in the outermost cells
+    if (!(index > -max_cell_index))
+    {
+        index = -max_cell_index;
+    }
+    else if (index > max_cell_index)
+    {
+        index = max_cell_index;
+    }
+    return static_cast<long long>(index);
+}
+
+Spatial_index::Cell_key
+Spatial_index::get_cell_key(long long column, long long row)
+{
+    return static_cast<Cell_key>((static_cast<unsigned long long>(column) << 32) ^
+                                 (static_cast<unsigned long long>(row) &
+                                  0xffffffffULL));
+}
+
+void
+Spatial_index::remove_from_cell(int id)
+{
+    const Point& location = locations[id];
+    unordered_map<Cell_key, vector<int>>::iterator it =
+        cells.find(get_cell_key(get_cell_index(location.x),
+                                get_cell_index(location.y)));
+
+    // order within a cell does not matter,
+    // so move the last id into the place of the removed one
+    vector<int>& ids = it->second;
+    vector<int>::iterator id_it = find(ids.begin(), ids.end(), id);
+    *id_it = ids.back();
+    ids.pop_back();
+
+    if (ids.empty())
+    {
+        cells.erase(it);
+    }
+}
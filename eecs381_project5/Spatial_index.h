@@ -0,0 +1,75 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+/***************************************************************************
+    Spatial_index is a uniform grid over the plane for finding
+    objects by location without looking at every object.
+    Each object is identified by the id of its name in the Name_table
+    and is kept in the square cell containing its location;
+    cells are created only when an object is in them,
+    so the grid has no bounds.
+    An object that moves must be told to the index with move().
+
+    Queries append the ids they find to a supplied vector,
+    in no particular order.
+***************************************************************************/
+
+#include "Geometry.h"
+#include <vector>
+#include <unordered_map>
+
+class Spatial_index
+{
+  public:
+      // create an empty index whose cells are cell_size_ on a side
+      explicit Spatial_index(double cell_size_);
+
+      // add an object at a location; the id must not be in the index
+      void insert(int id, Point location);
+
+      // remove an object; no error if the id is not present
+      void remove(int id);
+
+      // change the location of an object already in the index
+      void move(int id, Point location);
+
+      // is the id in the index?
+      bool contains(int id) const
+          {return id < static_cast<int>(present.size()) && present[id];}
+
+      // location of an object in the index
+      Point get_location(int id) const
+          {return locations[id];}
+
+      // number of objects in the index
+      int size() const
+          {return num_objects;}
+
+      // append the ids of the objects located exactly at the point
+      void find_at(Point, std::vector<int>&) const;
+
+      // append the ids of the objects no further than radius from center
+      void find_within(Point center, double radius, std::vector<int>&) const;
+
+  private:
+      typedef long long Cell_key;
+
+      double cell_size;
+      int num_objects;
+      std::unordered_map<Cell_key, std::vector<int>> cells;
+
+      // location and presence of each object, indexed by id
+      std::vector<Point> locations;
+      std::vector<char> present;
+
+      // column or row of the cell containing a coordinate
+      long long get_cell_index(double coordinate) const;
+
+      // key of the cell at a column and row
+      static Cell_key get_cell_key(long long column, long long row);
+
+      // take the id out of the cell it is listed in
+      void remove_from_cell(int id);
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include "Tanker.h"
 #include "Island.h"
+#include "Output.h"
+#include "Checkpoint.h"
+#include "Tick_intents.h"
 #include "Utility.h"
 
 using namespace std;
@@ -51,8 +54,9 @@ Tanker::set_load_destination(shared_ptr<Island> island_ptr)
         throw Error("Load and unload cargo destinations are the same!");
     }
 
-    cout << get_name() << " will load at " 
-         << load_destination->get_name() << endl;
+    Output::get_Instance().write(Output_sink::TANKER_WILL_LOAD_AT,
+                                 get_id(),
+                                 load_destination->get_id());
 
     tanker_cycle();
 }
@@ -72,8 +76,9 @@ Tanker::set_unload_destination(shared_ptr<Island> island_ptr)
         throw Error("Load and unload cargo destinations are the same!");
     }
 
-    cout << get_name() << " will unload at "
-         << unload_destination->get_name() << endl;
+    Output::get_Instance().write(Output_sink::TANKER_WILL_UNLOAD_AT,
+                                 get_id(),
+                                 unload_destination->get_id());
 
     tanker_cycle();
 }
@@ -83,7 +88,7 @@ Tanker::stop()
 {
     Ship::stop();
     reset_state();
-    cout << get_name() << " now has no cargo destinations" << endl;
+    Output::get_Instance().write(Output_sink::TANKER_NO_DESTINATIONS, get_id());
 }
 
 void
@@ -96,7 +101,8 @@ Tanker::update()
         if (tanker_state != NO_CARGO_DESTINATION)
         {
             reset_state();
-            cout << get_name() << " now has no cargo destinations" << endl;
+            Output::get_Instance().write(Output_sink::TANKER_NO_DESTINATIONS,
+                                         get_id());
         }
         return;
     }
@@ -138,8 +144,9 @@ Tanker::update()
         }
         else
         {
-            cargo += load_destination->provide_fuel(fuel_needed_to_fill_cargo);
-            cout << get_name() << " now has " << cargo << " of cargo" << endl;
+            Tick_intents::carry_out(Tick_intents::FUEL_TRANSFER,
+                                    [this, fuel_needed_to_fill_cargo]
+                                    {load_cargo(fuel_needed_to_fill_cargo);});
             return;
         }
     }
@@ -154,13 +161,74 @@ Tanker::update()
         }
         else
         {
-            unload_destination->accept_fuel(cargo);
-            cargo = 0.0;
+            Tick_intents::carry_out(Tick_intents::FUEL_TRANSFER,
+                                    [this]{unload_cargo();});
             return;
         }
     }
 }
 
+void
+Tanker::load_cargo(double fuel_needed_to_fill_cargo)
+{
+    cargo += load_destination->provide_fuel(fuel_needed_to_fill_cargo);
+    Output::get_Instance().write(Output_sink::TANKER_CARGO, get_id(), cargo);
+}
+
+void
+Tanker::unload_cargo()
+{
+    unload_destination->accept_fuel(cargo);
+    cargo = 0.0;
+}
+
+bool
+Tanker::is_dormant() const
+{
+    return (tanker_state == NO_CARGO_DESTINATION && Ship::is_dormant());
+}
+
+int
+Tanker::get_quiet_updates() const
+{
+    switch (tanker_state)
+    {
+        case NO_CARGO_DESTINATION:
+            return Ship::get_quiet_updates();
+        case MOVING_TO_LOADING:
+        case MOVING_TO_UNLOADING:
+            return (is_moving() ? Ship::get_quiet_updates() : 0);
+        default:
+            return 0;
+    }
+}
+
+void
+Tanker::save_state(Checkpoint_writer& writer) const
+{
+    Ship::save_state(writer);
+    writer.write_double(cargo);
+    writer.write_int(tanker_state);
+    writer.write_island(load_destination);
+    writer.write_island(unload_destination);
+}
+
+void
+Tanker::restore_state(Checkpoint_reader& reader)
+{
+    Ship::restore_state(reader);
+    cargo = reader.read_double();
+
+    int32_t state = reader.read_int();
+    if (state < NO_CARGO_DESTINATION || state > MOVING_TO_UNLOADING)
+    {
+        throw Error("Checkpoint file is damaged!");
+    }
+    tanker_state       = static_cast<Tanker_State_e>(state);
+    load_destination   = reader.read_island();
+    unload_destination = reader.read_island();
+}
+
 void
 Tanker::describe() const
 {
@@ -57,6 +57,18 @@ class Tanker : public Ship
       void update() override;
       void describe() const override;
 
+      // a Tanker with cargo destinations is never dormant,
+      // and is quiet only while sailing between them
+      bool is_dormant() const override;
+      int get_quiet_updates() const override;
+
+      const char* get_type_name() const override
+          {return "Tanker";}
+
+      // the cargo, state, and cargo destinations
+      void save_state(Checkpoint_writer&) const override;
+      void restore_state(Checkpoint_reader&) override;
+
   private:
       double cargo;
       double cargo_capacity;
@@ -77,6 +89,12 @@ class Tanker : public Ship
 
       // resets state and forgets destinations
       void reset_state();
+
+      // take on cargo from the load destination, as far as its fuel goes,
+      // or give all of the cargo to the unload destination;
+      // during an update, these are FUEL_TRANSFER steps
+      void load_cargo(double);
+      void unload_cargo();
 };
 
 #endif
@@ -0,0 +1,313 @@
+#include "Telemetry_view.h"
+#include "Model.h"
+#include "Name_table.h"
+#include "Change_set.h"
+#include "Geometry.h"
+#include "Utility.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace std;
+
+// bytes in the ring; enough for the changes of several
+// thousand ships over a tick
+const size_t ring_size = 1 << 20;
+
+// how long the writer thread waits when the ring is empty
+const chrono::milliseconds writer_poll_interval(2);
+
+// a DROPPED record: length, type, and the number dropped
+const size_t dropped_record_size =
+    sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint32_t);
+
+Telemetry_view::Telemetry_view(const string& file_name) :
+    file_descriptor(open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+    ring(ring_size),
+    ring_head(0),
+    ring_tail(0),
+    stopping(false),
+    part_start(0),
+    last_time(-1),
+    num_dropped(0),
+    record_time(-1),
+    record_name_id(-1)
+{
+    if (file_descriptor < 0)
+    {
+        throw Error("Could not open telemetry file!");
+    }
+
+    writer_thread = thread(&Telemetry_view::write_loop, this);
+}
+
+// the number of the last records dropped is written
+// once the writer thread has made room for it
+Telemetry_view::~Telemetry_view()
+{
+    while (num_dropped && !push_dropped())
+    {
+        this_thread::sleep_for(writer_poll_interval);
+    }
+    stopping.store(true, memory_order_release);
+    writer_thread.join();
+    close(file_descriptor);
+}
+
+void
+Telemetry_view::update_location(int id, Point location)
+{
+    begin_record(LOCATION, id);
+    append_field(location.x);
+    append_field(location.y);
+    push_record();
+}
+
+void
+Telemetry_view::update_fuel(int id, double fuel)
+{
+    begin_record(FUEL, id);
+    append_field(fuel);
+    push_record();
+}
+
+void
+Telemetry_view::update_speed(int id, double speed)
+{
+    begin_record(SPEED, id);
+    append_field(speed);
+    push_record();
+}
+
+void
+Telemetry_view::update_course(int id, double course)
+{
+    begin_record(COURSE, id);
+    append_field(course);
+    push_record();
+}
+
+void
+Telemetry_view::update_remove(int id)
+{
+    begin_record(REMOVE, id);
+    push_record();
+}
+
+// the removal comes first, as when a Change_set is applied
+void
+Telemetry_view::update_changes(const Change_set& change_set)
+{
+    for_each(change_set.begin(),
+             change_set.end(),
+             [this](const Change_set::Change& change)
+             {
+                 if (change.mask & Change_set::REMOVED)
+                 {
+                     update_remove(change.id);
+                 }
+                 if (change.mask & Change_set::LOCATION)
+                 {
+                     update_location(change.id, change.location);
+                 }
+                 if (change.mask & Change_set::FUEL)
+                 {
+                     update_fuel(change.id, change.fuel);
+                 }
+                 if (change.mask & Change_set::SPEED)
+                 {
+                     update_speed(change.id, change.speed);
+                 }
+                 if (change.mask & Change_set::COURSE)
+                 {
+                     update_course(change.id, change.course);
+                 }
+             });
+}
+
+// the TIME and NAME records are made in front of the record that
+// needs them, so that they are pushed or dropped together with it;
+// if they are dropped, they are made again for the next record
+void
+Telemetry_view::begin_record(Record_type_e type, int id)
+{
+    record.clear();
+    record_time = -1;
+    record_name_id = -1;
+
+    int time = Model::get_Instance().get_time();
+    if (time != last_time)
+    {
+        begin_part(TIME, -1);
+        append_field(static_cast<int32_t>(time));
+        end_part();
+        record_time = time;
+    }
+
+    if (id >= static_cast<int>(named.size()) || !named[id])
+    {
+        begin_part(NAME, id);
+        const string& name = Name_table::get_Instance().get_name(id);
+        record.insert(record.end(), name.begin(), name.end());
+        end_part();
+        record_name_id = id;
+    }
+
+    begin_part(type, id);
+}
+
+void
+Telemetry_view::begin_part(Record_type_e type, int id)
+{
+    // the length is filled in when the part is ended
+    part_start = record.size();
+    record.insert(record.end(), sizeof(uint16_t), 0);
+    record.push_back(static_cast<char>(type));
+    if (id != -1)
+    {
+        append_field(static_cast<int32_t>(id));
+    }
+}
+
+void
+Telemetry_view::end_part()
+{
+    uint16_t length = static_cast<uint16_t>(record.size() - part_start -
+                                            sizeof(length));
+    memcpy(record.data() + part_start, &length, sizeof(length));
+}
+
+template<typename T>
+void
+Telemetry_view::append_field(T value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    record.insert(record.end(), bytes, bytes + sizeof(value));
+}
+
+// only this thread moves the head, so the room found
+// can only grow until the record is copied
+bool
+Telemetry_view::push_record()
+{
+    end_part();
+
+    size_t head = ring_head.load(memory_order_relaxed);
+    size_t room = ring.size() - (head - ring_tail.load(memory_order_acquire));
+    size_t needed = record.size() + (num_dropped ? dropped_record_size : 0);
+    if (needed > room)
+    {
+        ++num_dropped;
+        return false;
+    }
+
+    if (num_dropped)
+    {
+        push_dropped();
+        head += dropped_record_size;
+    }
+
+    copy_to_ring(head, record.data(), record.size());
+    ring_head.store(head + record.size(), memory_order_release);
+
+    if (record_time != -1)
+    {
+        last_time = record_time;
+    }
+    if (record_name_id != -1)
+    {
+        if (record_name_id >= static_cast<int>(named.size()))
+        {
+            named.resize(record_name_id + 1, 0);
+        }
+        named[record_name_id] = 1;
+    }
+    return true;
+}
+
+bool
+Telemetry_view::push_dropped()
+{
+    size_t head = ring_head.load(memory_order_relaxed);
+    size_t room = ring.size() - (head - ring_tail.load(memory_order_acquire));
+    if (dropped_record_size > room)
+    {
+        return false;
+    }
+
+    char dropped[dropped_record_size];
+    uint16_t dropped_length = dropped_record_size - sizeof(dropped_length);
+    uint8_t dropped_type = DROPPED;
+    memcpy(dropped, &dropped_length, sizeof(dropped_length));
+    memcpy(dropped + sizeof(dropped_length),
+           &dropped_type,
+           sizeof(dropped_type));
+    memcpy(dropped + sizeof(dropped_length) + sizeof(dropped_type),
+           &num_dropped,
+           sizeof(num_dropped));
+    copy_to_ring(head, dropped, dropped_record_size);
+    ring_head.store(head + dropped_record_size, memory_order_release);
+    num_dropped = 0;
+    return true;
+}
+
+void
+Telemetry_view::copy_to_ring(size_t position, const char* bytes, size_t size)
+{
+    size_t offset = position & (ring.size() - 1);
+    size_t first_part = min(size, ring.size() - offset);
+    memcpy(ring.data() + offset, bytes, first_part);
+    memcpy(ring.data(), bytes + first_part, size - first_part);
+}
+
+// a reader that goes away would raise SIGPIPE, which is blocked
+// on this thread so that the write fails instead;
+// the head is read after stopping, so nothing pushed is left behind
+void
+Telemetry_view::write_loop()
+{
+    sigset_t pipe_signal;
+    sigemptyset(&pipe_signal);
+    sigaddset(&pipe_signal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_signal, nullptr);
+
+    bool failed = false;
+    size_t tail = ring_tail.load(memory_order_relaxed);
+    while (true)
+    {
+        bool stop = stopping.load(memory_order_acquire);
+        size_t head = ring_head.load(memory_order_acquire);
+        if (head == tail)
+        {
+            if (stop)
+            {
+                break;
+            }
+            this_thread::sleep_for(writer_poll_interval);
+            continue;
+        }
+
+        while (tail != head && !failed)
+        {
+            size_t offset = tail & (ring.size() - 1);
+            size_t size = min(head - tail, ring.size() - offset);
+            ssize_t written = write(file_descriptor, ring.data() + offset, size);
+            if (written < 0)
+            {
+                failed = errno != EINTR;
+                continue;
+            }
+            tail += written;
+            ring_tail.store(tail, memory_order_release);
+        }
+
+        // once the file has failed, what is pushed is discarded
+        tail = head;
+        ring_tail.store(tail, memory_order_release);
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef TELEMETRY_VIEW_H
+#define TELEMETRY_VIEW_H
+
+/***************************************************************************
+    A Telemetry_view is a View that streams every change to the
+    objects to a file or named pipe as compact binary records,
+    for a program outside of the simulation to follow it live.
+    Each record is its length, a uint16 counting the bytes after it,
+    then a uint8 Record_type_e and the fields for that type:
+        TIME      int32 time; the records after it are for that time
+        NAME      int32 id, then the characters of the name
+        LOCATION  int32 id, double x, double y
+        FUEL, SPEED, COURSE
+                  int32 id, double value
+        REMOVE    int32 id
+        DROPPED   uint32 number of records dropped just before it
+    A TIME record is written whenever the time of the Model has
+    changed since the last record, and the NAME record of an object
+    before its first other record, so a reader can skip any type it
+    does not know by its length alone. They go into the ring in one
+    piece with the record that needs them, so a reader never sees
+    a record without its time and name.
+    Numbers are in the byte order of the host, and are not aligned.
+
+    The records are copied into a ring buffer that a writer thread
+    of the view drains to the file; the two threads share only the
+    positions of the ring, so the simulation never waits on a slow
+    reader, nor takes a lock. If the ring is full, a record is dropped
+    instead, with the TIME and NAME records in front of it, and the
+    number of records dropped is written once there is room.
+    If the reader goes away, the rest of the records are discarded.
+***************************************************************************/
+
+#include "Geometry.h"
+#include "Views.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class Telemetry_view : public View
+{
+  public:
+      // the type of a record, its first byte after the length
+      enum Record_type_e : std::uint8_t
+      {
+          TIME     = 0,
+          NAME     = 1,
+          LOCATION = 2,
+          FUEL     = 3,
+          SPEED    = 4,
+          COURSE   = 5,
+          REMOVE   = 6,
+          DROPPED  = 7
+      };
+
+      // open the file and start the writer thread;
+      // opening a named pipe waits for its reader
+      // will throw Error("Could not open telemetry file!")
+      explicit Telemetry_view(const std::string& file_name);
+
+      // write the records left in the ring and the number of those
+      // dropped last, then stop the writer thread
+      ~Telemetry_view();
+
+      // forbid copy/move, construction/assignment
+      Telemetry_view(const Telemetry_view&) = delete;
+      Telemetry_view(Telemetry_view&&) = delete;
+      Telemetry_view& operator= (const Telemetry_view&) = delete;
+      Telemetry_view& operator= (Telemetry_view&&) = delete;
+
+      // write a record of the change
+      void update_location(int id, Point location) override;
+      void update_fuel(int id, double fuel) override;
+      void update_speed(int id, double speed) override;
+      void update_course(int id, double course) override;
+      void update_remove(int id) override;
+
+      // write a record of each field changed during a tick
+      void update_changes(const Change_set&) override;
+
+      // nothing is drawn
+      void draw() override {}
+      void clear() override {}
+
+  private:
+      int file_descriptor;
+
+      // the ring; the positions only grow, and are taken
+      // modulo its size, which is a power of two
+      std::vector<char> ring;
+      std::atomic<std::size_t> ring_head;    // written by the simulation
+      std::atomic<std::size_t> ring_tail;    // written by the writer thread
+      std::atomic<bool> stopping;
+
+      // used only by the simulation's thread
+      std::vector<char> record;           // the record being made
+      std::size_t part_start;             // where its last part starts
+      std::vector<char> named;            // has each id had its NAME record?
+      int last_time;
+      std::uint32_t num_dropped;
+
+      // the time and the id named by the TIME and NAME records
+      // in front of the record being made, or -1 for none
+      int record_time;
+      int record_name_id;
+
+      // started last, once everything it uses is ready
+      std::thread writer_thread;
+
+      // start a record of the type, for an object with the id,
+      // after the TIME and NAME records it needs
+      void begin_record(Record_type_e type, int id);
+
+      // start a part of the record being made, of the type and
+      // for the id, or for none if it is -1, and fill in the length
+      // of the last part started
+      void begin_part(Record_type_e type, int id);
+      void end_part();
+
+      // append a field to the record being made
+      template<typename T>
+      void append_field(T value);
+
+      // end the record being made and copy it into the ring, after
+      // a DROPPED record if any were dropped; if there is no room
+      // for all of it, drop it and return false
+      bool push_record();
+
+      // copy a DROPPED record into the ring if there is room for it,
+      // and return whether there was
+      bool push_dropped();
+
+      // copy the bytes into the ring from the position on,
+      // without handing them to the writer thread
+      void copy_to_ring(std::size_t position,
+                        const char* bytes,
+                        std::size_t size);
+
+      // write what is in the ring to the file until the view is destroyed
+      void write_loop();
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "Tick_intents.h"
+#include "Model.h"
+#include "Geometry.h"
+#include <algorithm>
+
+using namespace std;
+
+// the intents each thread is recording into
+thread_local Tick_intents* recording = nullptr;
+
+Tick_intents*
+Tick_intents::get_recording()
+{
+    return recording;
+}
+
+void
+Tick_intents::start_recording()
+{
+    recording = this;
+}
+
+void
+Tick_intents::stop_recording()
+{
+    recording = nullptr;
+}
+
+void
+Tick_intents::carry_out(Kind_e kind, const function<void()>& step)
+{
+    if (!recording)
+    {
+        step();
+        return;
+    }
+
+    Intent intent = {kind, {Output_sink::Event_e(), 0, -1, {0., 0., 0., 0.}}};
+    intent.event.id = static_cast<int>(recording->steps.size());
+    recording->intents.push_back(intent);
+    recording->steps.push_back(step);
+}
+
+void
+Tick_intents::add_event(const Output_sink::Event& event)
+{
+    Intent intent = {OUTPUT_EVENT, event};
+    intents.push_back(intent);
+}
+
+void
+Tick_intents::add_notification(Kind_e kind, int id, double value0, double value1)
+{
+    Intent intent = {kind, {Output_sink::Event_e(), id, -1, {value0, value1, 0., 0.}}};
+    intents.push_back(intent);
+}
+
+void
+Tick_intents::apply(int begin, int end) const
+{
+    Model& model = Model::get_Instance();
+    for_each(intents.begin() + begin,
+             intents.begin() + end,
+             [this, &model](const Intent& intent)
+             {
+                 const Output_sink::Event& event = intent.event;
+                 switch (intent.kind)
+                 {
+                     case OUTPUT_EVENT:
+                         Output::get_Instance().write(event);
+                         break;
+                     case NOTIFY_LOCATION:
+                         model.notify_location(event.id,
+                                               Point(event.value[0],
+                                                     event.value[1]));
+                         break;
+                     case NOTIFY_FUEL:
+                         model.notify_fuel(event.id, event.value[0]);
+                         break;
+                     case NOTIFY_SPEED:
+                         model.notify_speed(event.id, event.value[0]);
+                         break;
+                     case NOTIFY_COURSE:
+                         model.notify_course(event.id, event.value[0]);
+                         break;
+                     case NOTIFY_STATE:
+                         model.notify_state(event.id,
+                                            static_cast<int>(event.value[0]));
+                         break;
+                     case NOTIFY_GONE:
+                         model.notify_gone(event.id);
+                         break;
+                     case SHIP_SUNK:
+                         model.add_sunk_ship(event.id);
+                         break;
+                     case FUEL_TRANSFER:
+                     case HIT:
+                         steps[event.id]();
+                         break;
+                 }
+             });
+}
+
+void
+Tick_intents::clear()
+{
+    intents.clear();
+    steps.clear();
+}
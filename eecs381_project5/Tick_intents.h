@@ -0,0 +1,87 @@
+#ifndef TICK_INTENTS_H
+#define TICK_INTENTS_H
+
+/***************************************************************************
+    A Tick_intents holds what the updates of some Sim_objects intend
+    to do during a tick, so that the updates can be computed on
+    several threads, and their effects made afterwards one object
+    at a time in name order, just as if the objects had been updated
+    one after another.
+    While a Tick_intents is recording on a thread, the messages the
+    objects updated on that thread output, and the changes they
+    notify the Model of, are added to it instead of being made.
+    A step of an update that acts on another object, or depends
+    on another object's current state - a hit on a target, or fuel
+    given to or taken from an Island - is added too, and carried out
+    only when the intents are applied.
+    While its update is computed, an object changes only its own state,
+    which no other object looks at until the intents are applied.
+***************************************************************************/
+
+#include "Output.h"
+#include <vector>
+#include <functional>
+
+class Tick_intents
+{
+  public:
+      // kinds of intent
+      enum Kind_e
+      {
+          OUTPUT_EVENT,       // a message for Output
+          NOTIFY_LOCATION,    // changes for the Model to notify of
+          NOTIFY_FUEL,
+          NOTIFY_SPEED,
+          NOTIFY_COURSE,
+          NOTIFY_STATE,
+          NOTIFY_GONE,
+          SHIP_SUNK,          // a ship for the Model to remove
+          FUEL_TRANSFER,      // steps carried out when applied
+          HIT
+      };
+
+      // the intents recording on this thread, or nullptr
+      // if the objects updated on it act at once
+      static Tick_intents* get_recording();
+
+      // record what is done on this thread into this one,
+      // until recording is stopped
+      void start_recording();
+      static void stop_recording();
+
+      // carry out a FUEL_TRANSFER or HIT step of an update now,
+      // or add it if intents are recording on this thread
+      static void carry_out(Kind_e kind, const std::function<void()>& step);
+
+      // add a message
+      void add_event(const Output_sink::Event& event);
+
+      // add a change to notify of; the values are those of
+      // the notify function, with a state given as its value
+      void add_notification(Kind_e kind, int id,
+                            double value0 = 0., double value1 = 0.);
+
+      // the number of intents added so far
+      int size() const
+          {return static_cast<int>(intents.size());}
+
+      // make the intents from begin up to end, in the order added
+      void apply(int begin, int end) const;
+
+      // discard all of the intents
+      void clear();
+
+  private:
+      // a message is kept as its event; a change keeps its values
+      // in the event's, and a step keeps its index in steps as the id
+      struct Intent
+      {
+          Kind_e kind;
+          Output_sink::Event event;
+      };
+
+      std::vector<Intent> intents;
+      std::vector<std::function<void()>> steps;
+};
+
+#endif
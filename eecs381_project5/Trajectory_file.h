@@ -0,0 +1,50 @@
+#ifndef TRAJECTORY_FILE_H
+#define TRAJECTORY_FILE_H
+
+/***************************************************************************
+    Layout of a trajectory file, written by Trajectory_recorder
+    and read by Trajectory_reader.
+    The file is a Trajectory_header, then num_records fixed-size
+    Trajectory_records in the order they were made, so their times
+    never decrease, then the names of the objects in the records:
+    for each, its id, the length of its name, and the characters,
+    starting at names_offset.
+    Numbers are in the byte order of the host that wrote the file.
+***************************************************************************/
+
+#include <cstdint>
+
+// first bytes of every trajectory file, and the version of the layout
+const char trajectory_magic[4] = {'P', '5', 'T', 'R'};
+const std::uint32_t trajectory_version = 1;
+
+// state of a record that is not about a Ship,
+// and of the record made when an object is removed
+const std::int32_t trajectory_no_state = -1;
+const std::int32_t trajectory_removed  = -2;
+
+struct Trajectory_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t unused;
+    std::uint64_t num_records;
+    std::uint64_t names_offset;   // 0 until the file is complete
+};
+
+struct Trajectory_record
+{
+    std::int32_t time;
+    std::int32_t id;
+    std::int32_t state;           // a Ship_kinematics::State_e,
+                                  // or one of the values above
+    std::int32_t unused;
+    double x;
+    double y;
+    double course;
+    double speed;
+    double fuel;
+};
+
+#endif
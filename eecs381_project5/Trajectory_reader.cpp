@@ -0,0 +1,161 @@
+#include "Trajectory_reader.h"
+#include "Utility.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+Trajectory_reader::Trajectory_reader(const string& file_name) :
+    file_descriptor(open(file_name.c_str(), O_RDONLY)),
+    mapping(nullptr),
+    mapping_size(0),
+    records(nullptr),
+    num_records(0)
+{
+    if (file_descriptor < 0)
+    {
+        throw Error("Could not open trajectory file!");
+    }
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) != 0)
+    {
+        close(file_descriptor);
+        throw Error("Could not open trajectory file!");
+    }
+    mapping_size = file_status.st_size;
+
+    if (mapping_size < sizeof(Trajectory_header))
+    {
+        close(file_descriptor);
+        throw Error("Not a trajectory file!");
+    }
+
+    void* address = mmap(nullptr,
+                         mapping_size,
+                         PROT_READ,
+                         MAP_SHARED,
+                         file_descriptor,
+                         0);
+    if (address == MAP_FAILED)
+    {
+        close(file_descriptor);
+        throw Error("Could not open trajectory file!");
+    }
+    mapping = static_cast<const char*>(address);
+
+    // the header must match, and the records must fit in the file
+    const Trajectory_header* header =
+        reinterpret_cast<const Trajectory_header*>(mapping);
+    size_t records_size = (mapping_size - sizeof(Trajectory_header));
+    if (memcmp(header->magic, trajectory_magic, sizeof(header->magic)) ||
+        header->version != trajectory_version ||
+        header->record_size != sizeof(Trajectory_record) ||
+        header->num_records > records_size / sizeof(Trajectory_record))
+    {
+        munmap(const_cast<char*>(mapping), mapping_size);
+        close(file_descriptor);
+        throw Error("Not a trajectory file!");
+    }
+
+    records = reinterpret_cast<const Trajectory_record*>(mapping +
+                                                         sizeof(Trajectory_header));
+    num_records = header->num_records;
+
+    if (header->names_offset)
+    {
+        try
+        {
+            read_names(header->names_offset);
+        }
+        catch (Error&)
+        {
+            munmap(const_cast<char*>(mapping), mapping_size);
+            close(file_descriptor);
+            throw;
+        }
+    }
+}
+
+Trajectory_reader::~Trajectory_reader()
+{
+    munmap(const_cast<char*>(mapping), mapping_size);
+    close(file_descriptor);
+}
+
+const Trajectory_record*
+Trajectory_reader::begin_tick(int time) const
+{
+    return lower_bound(begin(),
+                       end(),
+                       time,
+                       [](const Trajectory_record& record, int time_)
+                       {return record.time < time_;});
+}
+
+const Trajectory_record*
+Trajectory_reader::end_tick(int time) const
+{
+    return upper_bound(begin(),
+                       end(),
+                       time,
+                       [](int time_, const Trajectory_record& record)
+                       {return time_ < record.time;});
+}
+
+// look back from the end of the tick for the object's last record
+const Trajectory_record*
+Trajectory_reader::find_state(int id, int time) const
+{
+    for (const Trajectory_record* it = end_tick(time); it != begin(); )
+    {
+        --it;
+        if (it->id == id)
+        {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+string
+Trajectory_reader::get_name(int id) const
+{
+    map<int, string>::const_iterator it = names.find(id);
+    if (it == names.end())
+    {
+        return string();
+    }
+    return it->second;
+}
+
+void
+Trajectory_reader::read_names(uint64_t names_offset)
+{
+    if (names_offset > mapping_size)
+    {
+        throw Error("Not a trajectory file!");
+    }
+
+    const char* next = mapping + names_offset;
+    const char* last = mapping + mapping_size;
+
+    while (last - next >= static_cast<ptrdiff_t>(2 * sizeof(int32_t)))
+    {
+        int32_t id, length;
+        memcpy(&id, next, sizeof(id));
+        memcpy(&length, next + sizeof(id), sizeof(length));
+        next += 2 * sizeof(int32_t);
+
+        if (length < 0 || last - next < length)
+        {
+            throw Error("Not a trajectory file!");
+        }
+        names[id] = string(next, length);
+        next += length;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef TRAJECTORY_READER_H
+#define TRAJECTORY_READER_H
+
+/***************************************************************************
+    Trajectory_reader gives access to a trajectory file written by
+    a Trajectory_recorder, for processing ship tracks after a run.
+    The file is mapped into memory read-only, so records are not
+    copied; since the records are in time order and all the same size,
+    the records of any tick are found by binary search.
+    It does not depend on the rest of the simulation, so it can be
+    built into other programs with just Trajectory_file.h and Utility.h.
+***************************************************************************/
+
+#include "Trajectory_file.h"
+#include <string>
+#include <map>
+#include <cstddef>
+
+class Trajectory_reader
+{
+  public:
+      // will throw Error("Could not open trajectory file!")
+      // or Error("Not a trajectory file!")
+      explicit Trajectory_reader(const std::string& file_name);
+      ~Trajectory_reader();
+
+      // forbid copy/move, construction/assignment
+      Trajectory_reader(const Trajectory_reader&) = delete;
+      Trajectory_reader(Trajectory_reader&&) = delete;
+      Trajectory_reader& operator= (const Trajectory_reader&) = delete;
+      Trajectory_reader& operator= (Trajectory_reader&&) = delete;
+
+      // all of the records, in time order
+      const Trajectory_record* begin() const
+          {return records;}
+      const Trajectory_record* end() const
+          {return records + num_records;}
+      std::size_t size() const
+          {return num_records;}
+
+      // the records made at a time; empty if there are none
+      const Trajectory_record* begin_tick(int time) const;
+      const Trajectory_record* end_tick(int time) const;
+
+      // the last record of an object made at or before a time,
+      // or nullptr if there is none
+      const Trajectory_record* find_state(int id, int time) const;
+
+      // the name of an object, or an empty string if the file
+      // was not completed and so has no names
+      std::string get_name(int id) const;
+
+  private:
+      int file_descriptor;
+      const char* mapping;
+      std::size_t mapping_size;
+      const Trajectory_record* records;
+      std::size_t num_records;
+      std::map<int, std::string> names;
+
+      // read the names that follow the records
+      void read_names(std::uint64_t names_offset);
+};
+
+#endif
@@ -0,0 +1,267 @@
+#include "Trajectory_recorder.h"
+#include "Model.h"
+#include "Name_table.h"
+#include "Change_set.h"
+#include "Geometry.h"
+#include "Utility.h"
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+
+// records the file has room for when it is created
+const size_t initial_capacity = 4096;
+
+Trajectory_recorder::Trajectory_recorder(const string& file_name) :
+    file_descriptor(open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)),
+    mapping(nullptr),
+    mapping_size(0),
+    capacity(0),
+    num_records(0),
+    header(nullptr),
+    records(nullptr),
+    stopped(false)
+{
+    if (file_descriptor < 0)
+    {
+        throw Error("Could not open trajectory file!");
+    }
+
+    try
+    {
+        map_file(initial_capacity);
+    }
+    catch (Error&)
+    {
+        close(file_descriptor);
+        throw;
+    }
+
+    memcpy(header->magic, trajectory_magic, sizeof(header->magic));
+    header->version      = trajectory_version;
+    header->record_size  = sizeof(Trajectory_record);
+    header->unused       = 0;
+    header->num_records  = 0;
+    header->names_offset = 0;
+}
+
+// cut the file to the records written, then add the names after them
+Trajectory_recorder::~Trajectory_recorder()
+{
+    if (mapping)
+    {
+        munmap(mapping, mapping_size);
+    }
+
+    off_t names_offset = sizeof(Trajectory_header) +
+                         num_records * sizeof(Trajectory_record);
+    if (ftruncate(file_descriptor, names_offset) == 0)
+    {
+        string names;
+        for_each(latest.begin(),
+                 latest.end(),
+                 [&names](const Trajectory_record& record)
+                 {
+                     if (record.id == -1)
+                     {
+                         return;
+                     }
+                     const string& name =
+                         Name_table::get_Instance().get_name(record.id);
+                     int32_t id     = record.id;
+                     int32_t length = static_cast<int32_t>(name.size());
+                     names.append(reinterpret_cast<const char*>(&id),
+                                  sizeof(id));
+                     names.append(reinterpret_cast<const char*>(&length),
+                                  sizeof(length));
+                     names.append(name);
+                 });
+
+        uint64_t offset = names_offset;
+        ssize_t written = pwrite(file_descriptor,
+                                 names.data(),
+                                 names.size(),
+                                 names_offset);
+        if (written == static_cast<ssize_t>(names.size()))
+        {
+            pwrite(file_descriptor,
+                   &offset,
+                   sizeof(offset),
+                   offsetof(Trajectory_header, names_offset));
+        }
+    }
+    close(file_descriptor);
+}
+
+void
+Trajectory_recorder::update_location(int id, Point location)
+{
+    Trajectory_record& record = get_latest(id);
+    record.x = location.x;
+    record.y = location.y;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_fuel(int id, double fuel)
+{
+    get_latest(id).fuel = fuel;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_speed(int id, double speed)
+{
+    get_latest(id).speed = speed;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_course(int id, double course)
+{
+    get_latest(id).course = course;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_state(int id, int state)
+{
+    get_latest(id).state = state;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_remove(int id)
+{
+    get_latest(id).state = trajectory_removed;
+    append(id);
+}
+
+void
+Trajectory_recorder::update_changes(const Change_set& change_set)
+{
+    for_each(change_set.begin(),
+             change_set.end(),
+             [this](const Change_set::Change& change)
+             {
+                 Trajectory_record& record = get_latest(change.id);
+                 if (change.mask & Change_set::REMOVED)
+                 {
+                     record.state = trajectory_removed;
+                 }
+                 if (change.mask & Change_set::LOCATION)
+                 {
+                     record.x = change.location.x;
+                     record.y = change.location.y;
+                 }
+                 if (change.mask & Change_set::FUEL)
+                 {
+                     record.fuel = change.fuel;
+                 }
+                 if (change.mask & Change_set::SPEED)
+                 {
+                     record.speed = change.speed;
+                 }
+                 if (change.mask & Change_set::COURSE)
+                 {
+                     record.course = change.course;
+                 }
+                 if (change.mask & Change_set::STATE)
+                 {
+                     record.state = change.state;
+                 }
+                 append(change.id);
+             });
+}
+
+Trajectory_record&
+Trajectory_recorder::get_latest(int id)
+{
+    if (id >= static_cast<int>(latest.size()))
+    {
+        Trajectory_record unseen = {0, -1, trajectory_no_state, 0,
+                                    0., 0., 0., 0., 0.};
+        latest.resize(id + 1, unseen);
+    }
+
+    Trajectory_record& record = latest[id];
+    record.id = id;
+    return record;
+}
+
+void
+Trajectory_recorder::append(int id)
+{
+    if (stopped)
+    {
+        return;
+    }
+
+    int time = Model::get_Instance().get_time();
+    if (num_records && time < records[num_records - 1].time)
+    {
+        stopped = true;
+        return;
+    }
+
+    // an error here would escape from the middle of a tick,
+    // so recording stops instead
+    if (num_records == capacity)
+    {
+        try
+        {
+            map_file(capacity * 2);
+        }
+        catch (Error&)
+        {
+            stopped = true;
+            return;
+        }
+    }
+
+    Trajectory_record& record = records[num_records++];
+    record              = latest[id];
+    record.time         = time;
+    header->num_records = num_records;
+}
+
+// the new mapping is made before the old one is given up,
+// so if the file cannot be grown, the old one is still good
+void
+Trajectory_recorder::map_file(size_t new_capacity)
+{
+    size_t new_size = sizeof(Trajectory_header) +
+                      new_capacity * sizeof(Trajectory_record);
+
+    if (ftruncate(file_descriptor, new_size) != 0)
+    {
+        throw Error("Could not grow trajectory file!");
+    }
+
+    void* address = mmap(nullptr,
+                         new_size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_SHARED,
+                         file_descriptor,
+                         0);
+    if (address == MAP_FAILED)
+    {
+        throw Error("Could not map trajectory file!");
+    }
+
+    if (mapping)
+    {
+        munmap(mapping, mapping_size);
+    }
+
+    mapping      = static_cast<char*>(address);
+    mapping_size = new_size;
+    capacity     = new_capacity;
+    header       = reinterpret_cast<Trajectory_header*>(mapping);
+    records      = reinterpret_cast<Trajectory_record*>(mapping +
+                                                        sizeof(Trajectory_header));
+}
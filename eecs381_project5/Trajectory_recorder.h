@@ -0,0 +1,85 @@
+#ifndef TRAJECTORY_RECORDER_H
+#define TRAJECTORY_RECORDER_H
+
+/***************************************************************************
+    A Trajectory_recorder is a View that writes the state of the
+    objects to a trajectory file (see Trajectory_file.h) instead of
+    drawing them. Every time an object changes, a record of its
+    whole state is appended, stamped with the time of the Model;
+    for a tick, there is one record for each object that changed.
+
+    The file is mapped into memory and records are copied straight
+    into it, so appending one allocates and formats nothing.
+    Room for more records is made ahead of time,
+    doubling the file whenever it fills up;
+    when the recorder is destroyed, the file is cut to the
+    records written, and the names of the objects are added.
+    If the file cannot be grown, recording stops there, and the
+    file is completed with the records already written.
+    Recording also stops if the time of the Model goes back, as when
+    an earlier checkpoint is restored, since a reader finds the
+    records of a tick by their being in time order.
+***************************************************************************/
+
+#include "Geometry.h"
+#include "Views.h"
+#include "Trajectory_file.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class Trajectory_recorder : public View
+{
+  public:
+      // will throw Error("Could not open trajectory file!")
+      explicit Trajectory_recorder(const std::string& file_name);
+      ~Trajectory_recorder();
+
+      // forbid copy/move, construction/assignment
+      Trajectory_recorder(const Trajectory_recorder&) = delete;
+      Trajectory_recorder(Trajectory_recorder&&) = delete;
+      Trajectory_recorder& operator= (const Trajectory_recorder&) = delete;
+      Trajectory_recorder& operator= (Trajectory_recorder&&) = delete;
+
+      // record a change made outside of a tick
+      void update_location(int id, Point location) override;
+      void update_fuel(int id, double fuel) override;
+      void update_speed(int id, double speed) override;
+      void update_course(int id, double course) override;
+      void update_state(int id, int state) override;
+      void update_remove(int id) override;
+
+      // record each object that changed during a tick once
+      void update_changes(const Change_set&) override;
+
+      // nothing is drawn
+      void draw() override {}
+      void clear() override {}
+
+  private:
+      int file_descriptor;
+      char* mapping;
+      std::size_t mapping_size;
+      std::size_t capacity;           // records the file has room for
+      std::size_t num_records;
+      Trajectory_header* header;
+      Trajectory_record* records;
+      bool stopped;                   // has recording stopped?
+
+      // latest state of each object, indexed by id
+      std::vector<Trajectory_record> latest;
+
+      // the entry in latest for the id, created if needed
+      Trajectory_record& get_latest(int id);
+
+      // append the latest state of the object, at the current time
+      void append(int id);
+
+      // make the file, and its mapping, large enough for the records;
+      // if this fails, the old mapping is kept
+      // will throw Error("Could not grow trajectory file!")
+      // or Error("Could not map trajectory file!")
+      void map_file(std::size_t new_capacity);
+};
+
+#endif
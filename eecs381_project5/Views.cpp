@@ -2,18 +2,95 @@
 #include "Navigation.h"
 #include "Views.h"
 #include "Utility.h"
+#include "Name_table.h"
+#include "Change_set.h"
+#include "Model.h"
+#include "World_snapshot.h"
 #include <iostream>
 #include <cmath>
-#include <list>
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <cstdio>
+#include <fstream>
 
 using namespace std;
 
+// largest size of a map allowed by set_large_size
+const int max_large_map_size = 10000;
+
+// largest number of pixels on a side of an exported image
+const int max_image_size = 16384;
+
+// size of the pieces in which a large map is written
+const size_t frame_block_size = 1 << 16;
+
+// cells of an object that is not on a map in diff mode
+const long long no_cell      = -1;
+const long long outside_cell = -2;
+
+// how far the bridge of a ship can see
+const double sight_distance = 20.;
+
 /// VIEW /////////////////////////////////////////////////////////
+// what the views on each thread draw from and to,
+// or nullptr for the Model's snapshot and cout
+thread_local const World_snapshot* draw_world = nullptr;
+thread_local ostream* draw_output = nullptr;
+
+inline const World_snapshot& drawn_world()
+{
+    return draw_world ? *draw_world : Model::get_Instance().get_world();
+}
+
+inline ostream& drawn_output()
+{
+    return draw_output ? *draw_output : cout;
+}
+
 View::View() {}
 View::~View() {}
+
+void
+View::set_draw_context(const World_snapshot* world, ostream* output)
+{
+    draw_world  = world;
+    draw_output = output;
+}
+
+void
+View::update_changes(const Change_set& change_set)
+{
+    for_each(change_set.begin(),
+             change_set.end(),
+             [this](const Change_set::Change& change)
+             {
+                 if (change.mask & Change_set::REMOVED)
+                 {
+                     update_remove(change.id);
+                 }
+                 if (change.mask & Change_set::LOCATION)
+                 {
+                     update_location(change.id, change.location);
+                 }
+                 if (change.mask & Change_set::FUEL)
+                 {
+                     update_fuel(change.id, change.fuel);
+                 }
+                 if (change.mask & Change_set::SPEED)
+                 {
+                     update_speed(change.id, change.speed);
+                 }
+                 if (change.mask & Change_set::COURSE)
+                 {
+                     update_course(change.id, change.course);
+                 }
+                 if (change.mask & Change_set::STATE)
+                 {
+                     update_state(change.id, change.state);
+                 }
+             });
+}
 //////////////////////////////////////////////////////////////////
 
 
@@ -21,8 +98,12 @@ View::~View() {}
 Map_View::Map_View() :
     size(25),
     scale(2.),
-    origin(Point(-10.,-10.))
-{}
+    origin(Point(-10.,-10.)),
+    diff_mode(false),
+    diff_map_valid(false)
+{
+    size_buffers();
+}
 
 Map_View::~Map_View()
 {
@@ -30,75 +111,123 @@ Map_View::~Map_View()
 }
 
 void
-Map_View::update_remove(const string& name)
+Map_View::clear()
 {
-    map<string, Point>::iterator it;
-    
-    if ((it = name_location_map.find(name)) !=
-        name_location_map.end())
+    diff_map_valid = false;
+    object_cells.clear();
+    cell_objects.clear();
+    outside_set.clear();
+}
+
+// append an int of at least the width, as setw would
+inline void append_int(string& text, int width, int value)
+{
+    char buffer[32];
+    int length = snprintf(buffer, sizeof(buffer), "%*d", width, value);
+    text.append(buffer, length);
+}
+
+// append a double in the format and precision the output has
+inline void append_double(string& text, double value)
+{
+    const ostream& output = drawn_output();
+    const char* format = "%.*g";
+    if (output.flags() & ios::fixed)
+    {
+        format = "%.*f";
+    }
+    else if (output.flags() & ios::scientific)
     {
-        name_location_map.erase(it);
+        format = "%.*e";
     }
+    int precision = static_cast<int>(output.precision());
+
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), format, precision, value);
+    if (length < static_cast<int>(sizeof(buffer)))
+    {
+        text.append(buffer, length);
+        return;
+    }
+
+    // a very large number is formatted right in the text
+    size_t old_size = text.size();
+    text.resize(old_size + length + 1);
+    snprintf(&text[old_size], length + 1, format, precision, value);
+    text.resize(old_size + length);
 }
 
 // prints out the current map
 void
 Map_View::draw()
 {
-    // 3D grid is local to draw
-    vector< vector<string> > grid;
-    grid.resize(size, vector<string>(size, ". "));
-    
-    cout << "Display size: " << size
-         << ", scale: " <<  scale
-         << ", origin: " <<  origin << endl;
+    if (diff_mode)
+    {
+        if (diff_map_valid)
+        {
+            draw_diff();
+        }
+        else
+        {
+            draw_diff_base();
+        }
+        return;
+    }
+
+    frame.clear();
+    frame += "Display size: ";
+    append_int(frame, 0, size);
+    frame += ", scale: ";
+    append_double(frame, scale);
+    frame += ", origin: (";
+    append_double(frame, origin.x);
+    frame += ", ";
+    append_double(frame, origin.y);
+    frame += ")\n";
     
-    // place objects into grid
-    list<string> outside_members;
-    for_each(name_location_map.begin(),
-             name_location_map.end(),
-             [&outside_members, this, &grid](pair<string, Point> obj)
-             {
-                 int x, y;
-                 
-                 // place object into grid if in range
-                 if (get_subscripts(x, y, obj.second))
-                 {
-                     if (grid[y][x] == ". ")
-                     {
-                         grid[y][x] = obj.first.substr(0,2);
-                     }
-                     else
-                     {
-                         grid[y][x] = "* ";
-                     }
-                 }
-                 // print out of range message
-                 else
-                 {
-                     outside_members.push_back(obj.first);
-                 }
-             });
+    // find the cell of each object in range
+    const Name_table& name_table = Name_table::get_Instance();
+    const World_snapshot& world = drawn_world();
+    occupied_cells.clear();
+    outside_ids.clear();
+    for (int id = 0; id < world.get_id_limit(); ++id)
+    {
+        if (!world.has_location(id))
+        {
+            continue;
+        }
+
+        int x, y;
+        if (get_subscripts(x, y, world.get_location(id)))
+        {
+            occupied_cells.push_back(
+                make_pair(static_cast<long long>(y) * size + x, id));
+        }
+        else
+        {
+            outside_ids.push_back(id);
+        }
+    }
+    sort(occupied_cells.begin(), occupied_cells.end());
     
-    // print outside members, if they exist
-    int num_members = static_cast<int>(outside_members.size());
-    if (num_members > 0)
+    // list outside members in name order, if they exist
+    if (!outside_ids.empty())
     {
-        for_each(outside_members.begin(),
-                 outside_members.end(),
-                 [&num_members](string name)
-                 {
-                     cout << name;
-                     if (num_members-- > 1)
-                     {
-                         cout << ", ";
-                     }
-                 });
-        
-        cout << " outside the map" << endl;
+        sort(outside_ids.begin(), outside_ids.end(), Name_order());
+        for (size_t i = 0; i < outside_ids.size(); ++i)
+        {
+            if (i > 0)
+            {
+                frame += ", ";
+            }
+            frame += name_table.get_name(outside_ids[i]);
+        }
+        frame += " outside the map\n";
     }
     
-    // print grid content to stdout
+    // grid content, top row first, so the occupied cells
+    // are taken from the end of the list
+    vector<pair<long long, int>>::const_iterator cell_it = occupied_cells.end();
     int axis = origin.y + scale*(size-1);
     for (int i = 0; i < size; ++i)
     {
@@ -106,31 +235,65 @@ Map_View::draw()
         // print out the y-coordinate axis number
         if (!((size-1-i) % 3))
         {
-            cout << setw(4) << axis << ' ';
+            append_int(frame, 4, axis);
+            frame += ' ';
         }
         else
         {
-            cout << "     ";
+            frame += "     ";
         }
         axis -= scale;
         
-        for (int j = 0; j < size; ++j)
+        // a cell with one object shows the start of its name,
+        // and one with more shows a *
+        size_t row_start = frame.size();
+        frame += empty_row;
+        long long row_first_cell = static_cast<long long>(size-1-i) * size;
+        while (cell_it != occupied_cells.begin() &&
+               (cell_it - 1)->first >= row_first_cell)
         {
-            // print grid content
-            cout << grid[size-1-i][j];
+            --cell_it;
+            long long cell = cell_it->first;
+            int num_objects = 1;
+            while (cell_it != occupied_cells.begin() &&
+                   (cell_it - 1)->first == cell)
+            {
+                --cell_it;
+                ++num_objects;
+            }
+
+            char* text = &frame[row_start + 2 * (cell - row_first_cell)];
+            if (num_objects == 1)
+            {
+                const string& name = name_table.get_name(cell_it->second);
+                text[0] = name[0];
+                text[1] = name[1];
+            }
+            else
+            {
+                text[0] = '*';
+            }
+        }
+        frame += '\n';
+
+        // a large map is written as it goes
+        if (frame.size() >= frame_block_size)
+        {
+            drawn_output().write(frame.data(), frame.size());
+            frame.clear();
         }
-        cout << endl;
     }
     
-    // print x-coordinate axis values
+    // x-coordinate axis values
     axis = origin.x;
     for (int i = 0; i < size; i += 3)
     {
-        cout << setw(6) << axis;
+        append_int(frame, 6, axis);
         axis += 3*scale;
     }
-    
-    cout << endl;
+    frame += '\n';
+
+    drawn_output().write(frame.data(), frame.size());
 }
 
 void
@@ -146,6 +309,7 @@ Map_View::set_size(int size_)
     }
     
     size = size_;
+    size_buffers();
 }
 
 void
@@ -157,12 +321,14 @@ Map_View::set_scale(double scale_)
     }
     
     scale = scale_;
+    clear();
 }
 
 void
 Map_View::set_origin(Point origin_)
 {
     origin = origin_;
+    clear();
 }
 
 void
@@ -171,6 +337,386 @@ Map_View::set_defaults()
     size   = 25;
     scale  = 2.;
     origin = Point(-10.,-10.);
+    size_buffers();
+}
+
+void
+Map_View::set_large_size(int size_)
+{
+    if (size_ > max_large_map_size)
+    {
+        throw Error("New map size is too big!");
+    }
+    else if (size_ <= 6)
+    {
+        throw Error("New map size is too small!");
+    }
+
+    size = size_;
+    size_buffers();
+}
+
+// the frame has room for the grid, the axes and a few lines more,
+// up to the size of a block written at once
+void
+Map_View::size_buffers()
+{
+    empty_row.clear();
+    for (int i = 0; i < size; ++i)
+    {
+        empty_row += ". ";
+    }
+
+    size_t frame_size = size * (2 * static_cast<size_t>(size) + 6) + 1024;
+    frame.reserve(min(frame_size, frame_block_size + empty_row.size() + 1024));
+
+    // a map of the old size is no use for diff mode
+    clear();
+}
+
+void
+Map_View::set_diff_mode(bool diff_mode_)
+{
+    diff_mode = diff_mode_;
+    clear();
+}
+
+// the whole map is drawn as usual, and the cell of every object
+// is found again from the snapshot
+void
+Map_View::draw_diff_base()
+{
+    diff_mode = false;
+    draw();
+    diff_mode = true;
+
+    clear();
+    const World_snapshot& world = drawn_world();
+    object_cells.assign(world.get_id_limit(), no_cell);
+    for (int id = 0; id < world.get_id_limit(); ++id)
+    {
+        if (world.has_location(id))
+        {
+            long long cell = get_cell(world.get_location(id));
+            object_cells[id] = cell;
+            if (cell == outside_cell)
+            {
+                outside_set.insert(id);
+            }
+            else
+            {
+                cell_objects[cell].push_back(id);
+            }
+        }
+    }
+    diff_map_valid = true;
+}
+
+// only the objects that have moved or gone are looked at;
+// a cell is written if what it shows differs from before the moves
+void
+Map_View::draw_diff()
+{
+    const World_snapshot& world = drawn_world();
+    if (static_cast<int>(object_cells.size()) < world.get_id_limit())
+    {
+        object_cells.resize(world.get_id_limit(), no_cell);
+    }
+
+    changed_cells.clear();
+    bool outside_changed = false;
+    const vector<int>& moved_ids = world.get_moved_ids();
+    for_each(moved_ids.begin(),
+             moved_ids.end(),
+             [this, &world, &outside_changed](int id)
+             {
+                 long long old_cell = object_cells[id];
+                 long long new_cell = world.has_location(id) ?
+                                      get_cell(world.get_location(id)) :
+                                      no_cell;
+                 if (new_cell == old_cell)
+                 {
+                     return;
+                 }
+
+                 if (old_cell == outside_cell)
+                 {
+                     outside_set.erase(id);
+                     outside_changed = true;
+                 }
+                 else if (old_cell != no_cell)
+                 {
+                     leave_cell(id, old_cell);
+                 }
+
+                 if (new_cell == outside_cell)
+                 {
+                     outside_set.insert(id);
+                     outside_changed = true;
+                 }
+                 else if (new_cell != no_cell)
+                 {
+                     enter_cell(id, new_cell);
+                 }
+                 object_cells[id] = new_cell;
+             });
+
+    // the cells that show something else, top row first
+    changed_list.clear();
+    for_each(changed_cells.begin(),
+             changed_cells.end(),
+             [this](const pair<const long long, Glyph>& cell)
+             {
+                 Glyph glyph = get_glyph(cell.first);
+                 if (glyph != cell.second)
+                 {
+                     changed_list.push_back(make_pair(cell.first, glyph));
+                 }
+             });
+    sort(changed_list.begin(),
+         changed_list.end(),
+         [this](const pair<long long, Glyph>& lhs,
+                const pair<long long, Glyph>& rhs)
+         {
+             long long lhs_row = lhs.first / size, rhs_row = rhs.first / size;
+             return (lhs_row != rhs_row) ? lhs_row > rhs_row :
+                                           lhs.first < rhs.first;
+         });
+
+    frame.clear();
+    frame += "Map changes: ";
+    append_int(frame, 0, static_cast<int>(changed_list.size()));
+    frame += '\n';
+
+    if (outside_changed)
+    {
+        const Name_table& name_table = Name_table::get_Instance();
+        if (outside_set.empty())
+        {
+            frame += "Nothing outside the map\n";
+        }
+        else
+        {
+            for (set<int, Name_order>::const_iterator it = outside_set.begin();
+                 it != outside_set.end();
+                 ++it)
+            {
+                if (it != outside_set.begin())
+                {
+                    frame += ", ";
+                }
+                frame += name_table.get_name(*it);
+            }
+            frame += " outside the map\n";
+        }
+    }
+
+    for_each(changed_list.begin(),
+             changed_list.end(),
+             [this](const pair<long long, Glyph>& cell)
+             {
+                 append_int(frame, 0, size - 1 - static_cast<int>(cell.first / size));
+                 frame += ' ';
+                 append_int(frame, 0, static_cast<int>(cell.first % size));
+                 frame += ' ';
+                 frame += cell.second.first;
+                 frame += cell.second.second;
+                 frame += '\n';
+             });
+
+    drawn_output().write(frame.data(), frame.size());
+}
+
+long long
+Map_View::get_cell(Point location)
+{
+    int x, y;
+    if (!get_subscripts(x, y, location))
+    {
+        return outside_cell;
+    }
+    return static_cast<long long>(y) * size + x;
+}
+
+// what a cell showed is noted before it is first changed
+void
+Map_View::leave_cell(int id, long long cell)
+{
+    changed_cells.insert(make_pair(cell, get_glyph(cell)));
+
+    unordered_map<long long, vector<int>>::iterator it = cell_objects.find(cell);
+    vector<int>& ids = it->second;
+    *find(ids.begin(), ids.end(), id) = ids.back();
+    ids.pop_back();
+    if (ids.empty())
+    {
+        cell_objects.erase(it);
+    }
+}
+
+void
+Map_View::enter_cell(int id, long long cell)
+{
+    changed_cells.insert(make_pair(cell, get_glyph(cell)));
+    cell_objects[cell].push_back(id);
+}
+
+// as in draw, a cell with one object shows the start of its name,
+// and one with more shows a *
+Map_View::Glyph
+Map_View::get_glyph(long long cell) const
+{
+    unordered_map<long long, vector<int>>::const_iterator it =
+        cell_objects.find(cell);
+    if (it == cell_objects.end())
+    {
+        return Glyph('.', ' ');
+    }
+    if (it->second.size() > 1)
+    {
+        return Glyph('*', ' ');
+    }
+    const string& name = Name_table::get_Instance().get_name(it->second.front());
+    return Glyph(name[0], name[1]);
+}
+
+// the objects are counted in one pass over them into a sorted list
+// of the occupied pixels, from which the rows are written in turn
+void
+Map_View::export_image(const string& file_name, int pixels)
+{
+    if (pixels <= 0 || pixels > max_image_size)
+    {
+        throw Error("Image size is out of range!");
+    }
+
+    // the locations of all of the objects
+    const World_snapshot& world = Model::get_Instance().get_world();
+    vector<Point> object_locations;
+    for (int id = 0; id < world.get_id_limit(); ++id)
+    {
+        if (world.has_location(id))
+        {
+            object_locations.push_back(world.get_location(id));
+        }
+    }
+
+    // the square around all of the objects, with the objects
+    // on its top and right edges in the last pixel
+    double min_x = 0., min_y = 0., extent = 1.;
+    if (!object_locations.empty())
+    {
+        Point first = object_locations.front();
+        double max_x = first.x, max_y = first.y;
+        min_x = first.x;
+        min_y = first.y;
+        for_each(object_locations.begin(),
+                 object_locations.end(),
+                 [&min_x, &min_y, &max_x, &max_y](Point location)
+                 {
+                     min_x = min(min_x, location.x);
+                     min_y = min(min_y, location.y);
+                     max_x = max(max_x, location.x);
+                     max_y = max(max_y, location.y);
+                 });
+        extent = max(max_x - min_x, max_y - min_y);
+        if (extent <= 0.)
+        {
+            extent = 1.;
+        }
+    }
+    double pixel_size = extent / pixels;
+
+    // the pixels, counted row by row from the top
+    vector<long long> occupied_pixels;
+    occupied_pixels.reserve(object_locations.size());
+    for_each(object_locations.begin(),
+             object_locations.end(),
+             [&occupied_pixels, min_x, min_y, pixel_size, pixels]
+             (Point location)
+             {
+                 int x = min(int((location.x - min_x) / pixel_size), pixels - 1);
+                 int y = min(int((location.y - min_y) / pixel_size), pixels - 1);
+                 occupied_pixels.push_back(
+                     static_cast<long long>(pixels - 1 - y) * pixels + x);
+             });
+    sort(occupied_pixels.begin(), occupied_pixels.end());
+
+    // the most objects in any pixel sets the scale
+    int max_count = 1;
+    for (size_t i = 0, count = 1; i < occupied_pixels.size(); ++i, ++count)
+    {
+        if (i + 1 == occupied_pixels.size() ||
+            occupied_pixels[i + 1] != occupied_pixels[i])
+        {
+            max_count = max(max_count, static_cast<int>(count));
+            count = 0;
+        }
+    }
+
+    bool color = file_name.size() >= 4 &&
+                 file_name.compare(file_name.size() - 4, 4, ".ppm") == 0;
+    int max_value = color ? 255 : min(max_count, 65535);
+    int sample_size = (max_value > 255) ? 2 : 1;
+    int pixel_bytes = color ? 3 : sample_size;
+
+    ofstream file(file_name.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!file)
+    {
+        throw Error("Could not write image file!");
+    }
+    file << (color ? "P6" : "P5") << '\n'
+         << pixels << ' ' << pixels << '\n'
+         << max_value << '\n';
+
+    vector<unsigned char> row(static_cast<size_t>(pixels) * pixel_bytes);
+    vector<long long>::const_iterator pixel_it = occupied_pixels.begin();
+    for (int y = 0; y < pixels; ++y)
+    {
+        fill(row.begin(), row.end(), 0);
+        long long row_end = static_cast<long long>(y + 1) * pixels;
+        while (pixel_it != occupied_pixels.end() && *pixel_it < row_end)
+        {
+            long long pixel = *pixel_it;
+            int count = 0;
+            while (pixel_it != occupied_pixels.end() && *pixel_it == pixel)
+            {
+                ++pixel_it;
+                ++count;
+            }
+
+            unsigned char* sample = &row[(pixel - row_end + pixels) * pixel_bytes];
+            if (color)
+            {
+                // from blue for one object to red for the most
+                double heat = (max_count > 1) ?
+                              double(count - 1) / (max_count - 1) : 1.;
+                sample[0] = static_cast<unsigned char>(255 * heat);
+                sample[1] = static_cast<unsigned char>(64 * (1. - heat));
+                sample[2] = static_cast<unsigned char>(255 * (1. - heat));
+            }
+            else
+            {
+                // samples above 255 take two bytes, most significant first
+                int value = min(count, max_value);
+                if (sample_size == 2)
+                {
+                    sample[0] = static_cast<unsigned char>(value >> 8);
+                    sample[1] = static_cast<unsigned char>(value & 0xff);
+                }
+                else
+                {
+                    sample[0] = static_cast<unsigned char>(value);
+                }
+            }
+        }
+        file.write(reinterpret_cast<const char*>(&row[0]), row.size());
+    }
+
+    if (!file)
+    {
+        throw Error("Could not write image file!");
+    }
 }
 
 bool
@@ -200,7 +746,9 @@ Map_View::get_subscripts(int &ix, int &iy, Point location)
 
 
 /// SAILING VIEW /////////////////////////////////////////////////
-Sailing_View::Sailing_View()
+Sailing_View::Sailing_View() :
+    ranking(BY_NAME),
+    max_ships(0)
 {}
 
 Sailing_View::~Sailing_View()
@@ -209,91 +757,153 @@ Sailing_View::~Sailing_View()
 }
 
 void
-Sailing_View::update_fuel(const std::string& name, double fuel)
+Sailing_View::set_lowest_fuel(int count)
 {
-    map<string, Ship_Data>::iterator it;
-    
-    if ((it = ship_data_map.find(name)) != ship_data_map.end())
-    {
-        it->second.fuel = fuel;
-    }
-    else
-    {
-        ship_data_map[name] = {fuel,0.,0.};
-    }
+    set_ranking(BY_LOW_FUEL, count);
 }
 
 void
-Sailing_View::update_speed(const std::string& name, double speed)
+Sailing_View::set_highest_speed(int count)
 {
-    map<string, Ship_Data>::iterator it;
-    
-    if ((it = ship_data_map.find(name)) != ship_data_map.end())
-    {
-        it->second.speed = speed;
-    }
-    else
-    {
-        ship_data_map[name] = {0.,speed,0.};
-    }
+    set_ranking(BY_HIGH_SPEED, count);
 }
 
 void
-Sailing_View::update_course(const std::string& name, double course)
+Sailing_View::set_name_prefix(const string& prefix)
 {
-    map<string, Ship_Data>::iterator it;
-    
-    if ((it = ship_data_map.find(name)) != ship_data_map.end())
-    {
-        it->second.course = course;
-    }
-    else
+    name_prefix = prefix;
+}
+
+void
+Sailing_View::set_defaults()
+{
+    ranking = BY_NAME;
+    max_ships = 0;
+    name_prefix.clear();
+}
+
+void
+Sailing_View::set_ranking(Ranking_e ranking_, int count)
+{
+    if (count <= 0)
     {
-        ship_data_map[name] = {0.,0.,course};
+        throw Error("Number of ships must be positive!");
     }
+    ranking = ranking_;
+    max_ships = count;
 }
 
-void
-Sailing_View::update_remove(const string& name)
+// right-justify what was appended from the start in a field
+// of the width, as setw would
+inline void pad_field(string& text, size_t start, size_t width)
 {
-    map<string, Ship_Data>::iterator it;
-    
-    if ((it = ship_data_map.find(name)) != ship_data_map.end())
+    size_t length = text.size() - start;
+    if (length < width)
     {
-        ship_data_map.erase(it);
+        text.insert(start, width - length, ' ');
     }
 }
 
+// a ranking is found with a partial sort, which only puts
+// the ships that are shown in order; ties go by name
 void
 Sailing_View::draw()
 {
-    cout << "----- Sailing Data -----" << endl;
-    cout << setw(10) << "Ship" << setw(10) << "Fuel"
-         << setw(10) << "Course" << setw(10) << "Speed" << endl;
-    
-    for_each(ship_data_map.begin(),
-             ship_data_map.end(),
-             [this](pair<string, Ship_Data> obj)
+    const Name_table& name_table = Name_table::get_Instance();
+    const World_snapshot& world = drawn_world();
+
+    shown_ids.clear();
+    for (int id = 0; id < world.get_id_limit(); ++id)
+    {
+        if (world.has_ship_data(id) &&
+            name_table.get_name(id).compare(0,
+                                            name_prefix.size(),
+                                            name_prefix) == 0)
+        {
+            shown_ids.push_back(id);
+        }
+    }
+
+    size_t num_shown = shown_ids.size();
+    if (ranking != BY_NAME && static_cast<size_t>(max_ships) < num_shown)
+    {
+        num_shown = max_ships;
+    }
+
+    switch (ranking)
+    {
+        case BY_NAME:
+            sort(shown_ids.begin(), shown_ids.end(), Name_order());
+            break;
+        case BY_LOW_FUEL:
+            partial_sort(shown_ids.begin(),
+                         shown_ids.begin() + num_shown,
+                         shown_ids.end(),
+                         [&world](int lhs, int rhs)
+                         {
+                             if (world.get_fuel(lhs) != world.get_fuel(rhs))
+                             {
+                                 return world.get_fuel(lhs) < world.get_fuel(rhs);
+                             }
+                             return Name_order()(lhs, rhs);
+                         });
+            break;
+        case BY_HIGH_SPEED:
+            partial_sort(shown_ids.begin(),
+                         shown_ids.begin() + num_shown,
+                         shown_ids.end(),
+                         [&world](int lhs, int rhs)
+                         {
+                             if (world.get_speed(lhs) != world.get_speed(rhs))
+                             {
+                                 return world.get_speed(lhs) > world.get_speed(rhs);
+                             }
+                             return Name_order()(lhs, rhs);
+                         });
+            break;
+    }
+
+    frame.clear();
+    frame += "----- Sailing Data -----\n";
+    frame += "      Ship      Fuel    Course     Speed\n";
+    for_each(shown_ids.begin(),
+             shown_ids.begin() + num_shown,
+             [this, &name_table, &world](int id)
              {
-                 cout << setw(10) << obj.first
-                      << setw(10) << obj.second.fuel
-                      << setw(10) << obj.second.course
-                      << setw(10) << obj.second.speed << endl;
+                 size_t start = frame.size();
+                 frame += name_table.get_name(id);
+                 pad_field(frame, start, 10);
+
+                 start = frame.size();
+                 append_double(frame, world.get_fuel(id));
+                 pad_field(frame, start, 10);
+
+                 start = frame.size();
+                 append_double(frame, world.get_course(id));
+                 pad_field(frame, start, 10);
+
+                 start = frame.size();
+                 append_double(frame, world.get_speed(id));
+                 pad_field(frame, start, 10);
+
+                 frame += '\n';
              });
+
+    drawn_output().write(frame.data(), frame.size());
 }
 //////////////////////////////////////////////////////////////////
 
 
 /// BRIDGE VIEW //////////////////////////////////////////////////
-Bridge_View::Bridge_View(const string &name_,
-                         Point location_,
-                         double heading_,
-                         bool sunk_) :
+Bridge_View::Bridge_View(int ownship_id_) :
     x_size(19),
     y_size(3),
     scale(10.),
     origin(-90.),
-    ownship({name_, location_, heading_, sunk_})
+    ownship_id(ownship_id_),
+    removal_count(Model::get_Instance().get_world().
+                      get_removal_count(ownship_id_)),
+    sunk(false)
 {}
 
 Bridge_View::~Bridge_View()
@@ -301,104 +911,71 @@ Bridge_View::~Bridge_View()
     clear();
 }
 
+// the ownship has sunk once the snapshot has removed it, which
+// keeps where it was; the snapshot drawn may be older than the
+// Model's, so the removal is only seen once it is drawn
 void
-Bridge_View::update_location(const std::string& name_, Point location_)
-{
-    if (name_ == ownship.name)
-    {
-        ownship.location = location_;
-    }
-    else
-    {
-        map<string, Point>::iterator it;
-        
-        if ((it = name_location_map.find(name_)) !=
-            name_location_map.end())
-        {
-            it->second = location_;
-        }
-        else
-        {
-            name_location_map[name_] = location_;
-        }
-    }
-}
-
-void
-Bridge_View::update_course(const std::string& name_, double heading_)
+Bridge_View::draw()
 {
-    if (name_ == ownship.name)
-    {
-        ownship.heading = heading_;
-    }
-}
+    const Name_table& name_table = Name_table::get_Instance();
+    const World_snapshot& world = drawn_world();
+    ostream& output = drawn_output();
+    Point location = world.get_location(ownship_id);
 
-void
-Bridge_View::update_remove(const std::string& name_)
-{
-    // check if removed is ownship
-    if (name_ == ownship.name)
+    if (world.get_removal_count(ownship_id) != removal_count)
     {
-        ownship.sunk = true;
-        clear();
-    }
-    else
-    {
-        map<string, Point>::iterator it;
-        
-        if ((it = name_location_map.find(name_)) !=
-            name_location_map.end())
-        {
-            name_location_map.erase(it);
-        }
+        sunk = true;
     }
-}
 
-void
-Bridge_View::draw()
-{
-    if (ownship.sunk)
+    if (sunk)
     {
-        cout << "Bridge view from " << ownship.name
-             << " sunk at " << ownship.location << endl;
+        output << "Bridge view from " << name_table.get_name(ownship_id)
+             << " sunk at " << location << '\n';
         
         for (int i = 0; i < y_size; ++i)
         {
-            cout << "     w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-"
-                 << endl;
+            output << "     w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-w-"
+                 << '\n';
         }
     }
     else
     {
         // store ship/island locations for printing
         vector<string> grid(x_size, ". ");
+        double heading = world.get_course(ownship_id);
         
-        cout << "Bridge view from " << ownship.name << " position "
-             << ownship.location << " heading "
-             << ownship.heading << endl;
+        output << "Bridge view from " << name_table.get_name(ownship_id)
+             << " position "
+             << location << " heading "
+             << heading << '\n';
         
-        // place objects into grid after bearing calculation
-        for_each(name_location_map.begin(),
-                 name_location_map.end(),
-                 [this, &grid](pair<string, Point> obj)
+        // only the objects within sight are looked at,
+        // and their bearings are calculated to place them into grid
+        sighted_ids.clear();
+        world.find_within(location, sight_distance, sighted_ids);
+        for_each(sighted_ids.begin(),
+                 sighted_ids.end(),
+                 [this, &grid, &name_table, &world, location, heading](int id)
                  {
-                     double distance = cartesian_distance(ownship.location, obj.second);
+                     Point other = world.get_location(id);
+                     if (id == ownship_id ||
+                         cartesian_distance(location, other) < 0.005)
+                     {
+                         return;
+                     }
                      
-                     if (distance <= 20. && distance >= 0.005)
+                     int x;
+                     
+                     // place object into grid if in range
+                     if (get_x_coordinate(x, calc_angle(location, heading, other)))
                      {
-                         int x;
-                         
-                         // place object into grid if in range
-                         if (get_x_coordinate(x, calc_angle(obj.second)))
+                         if (grid[x] == ". ")
                          {
-                             if (grid[x] == ". ")
-                             {
-                                 grid[x] = obj.first.substr(0,2);
-                             }
-                             else
-                             {
-                                 grid[x] = "**";
-                             }
+                             grid[x] = name_table.get_name(id).substr(0,2);
+                         }
+                         else
+                         {
+                             grid[x] = "**";
                          }
                      }
                  });
@@ -406,25 +983,25 @@ Bridge_View::draw()
         // print grid content to stdout
         for (int i = 0; i < y_size - 1; ++i)
         {
-            cout << "     . . . . . . . . . . . . . . . . . . . "
-                 << endl;
+            output << "     . . . . . . . . . . . . . . . . . . . "
+                 << '\n';
         }
-        cout << "     ";
+        output << "     ";
         for (int i = 0; i < x_size; ++i)
         {
-            cout << grid[i];
+            output << grid[i];
         }
-        cout << endl;
+        output << '\n';
     }
     
     // print x-coordinate axis values
     int axis = static_cast<int>(origin);
     for (int i = 0; i < x_size; i += 3)
     {
-        cout << setw(6) << axis;
+        output << setw(6) << axis;
         axis += 3*static_cast<int>(scale);
     }
-    cout << endl;
+    output << '\n';
 }
 
 bool
@@ -451,11 +1028,11 @@ Bridge_View::get_x_coordinate(int &ix, double angle)
 }
 
 double
-Bridge_View::calc_angle(Point other)
+Bridge_View::calc_angle(Point location, double heading, Point other)
 {
-    Compass_position compass_position(ownship.location, other);
+    Compass_position compass_position(location, other);
     
-    double angle = compass_position.bearing - ownship.heading;
+    double angle = compass_position.bearing - heading;
     
     if (angle < -180.)
     {
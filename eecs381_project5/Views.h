@@ -1,29 +1,57 @@
 #ifndef VIEWS_H
 #define VIEWS_H
 
+#include "Name_table.h"
 #include <string>
-#include <map>
+#include <iosfwd>
 #include <memory>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 struct Point;
 class Ship;
+class Change_set;
+class World_snapshot;
 
 class View
 {
   public:
       View();
       virtual ~View() = 0;
-      virtual void update_location(const std::string&, Point) {}
-      virtual void update_fuel(const std::string&, double) {}
-      virtual void update_speed(const std::string&, double) {}
-      virtual void update_course(const std::string&, double) {}
-      virtual void update_remove(const std::string&) = 0;
+      // a View attached to the Model is told of every change; one that
+      // is not reads the Model's World_snapshot when it draws instead
+      // objects are identified by the id of their name in the Name_table
+      virtual void update_location(int, Point) {}
+      virtual void update_fuel(int, double) {}
+      virtual void update_speed(int, double) {}
+      virtual void update_course(int, double) {}
+      // the state is a Ship_kinematics::State_e
+      virtual void update_state(int, int) {}
+      virtual void update_remove(int) {}
+
+      // apply all of the changes collected during a tick;
+      // by default, each change is passed to the functions above
+      virtual void update_changes(const Change_set&);
+
       virtual void draw() = 0;
       virtual void clear() = 0;
       virtual void set_size(int) {}
       virtual void set_scale(double) {}
       virtual void set_origin(Point) {}
       virtual void set_defaults() {}
+      virtual void set_large_size(int) {}
+      virtual void export_image(const std::string&, int) {}
+      virtual void set_lowest_fuel(int) {}
+      virtual void set_highest_speed(int) {}
+      virtual void set_name_prefix(const std::string&) {}
+      virtual void set_diff_mode(bool) {}
+
+      // the Views that are not attached draw from the Model's
+      // World_snapshot to cout, unless the thread that draws them
+      // has given a snapshot and a stream of its own
+      static void set_draw_context(const World_snapshot*, std::ostream*);
 };
 
 class Map_View : public View
@@ -33,24 +61,15 @@ class Map_View : public View
       Map_View();
       ~Map_View();
     
-      // Save the supplied name and location
-      // for future use in a draw() call
-      // If the name is already present,
-      // the new location replaces the previous one.
-      void update_location(const std::string& name, Point location) override
-          {name_location_map[name] = location;}
-    
-      // Remove the name and its location;
-      // no error if the name is not present.
-      void update_remove(const std::string&) override;
-    
-      // prints out the current map
+      // prints out the current map of the objects in the Model's
+      // World_snapshot, formatted into a buffer and written
+      // in one piece, or in large pieces for a large map;
+      // in diff mode, after the first map, only the cells that
+      // have changed since the last draw are written
       void draw() override;
     
-      // Discard the saved information -
-      // drawing will show only a empty pattern
-      void clear() override
-          {name_location_map.clear();}
+      // forget the map kept for diff mode, so the next draw is whole
+      void clear() override;
     
       // modify the display parameters
       // if the size is out of bounds
@@ -67,12 +86,78 @@ class Map_View : public View
     
       // set the parameters to the default values
       void set_defaults();
+
+      // allow a size larger than set_size does, for seeing
+      // a whole fleet; only the occupied cells are kept
+      // will throw Error("New map size is too big!")
+      // or Error("New map size is too small!")
+      void set_large_size(int) override;
+
+      // write a square image of the whole area the objects are in,
+      // with the number of objects in each pixel; a file name ending
+      // in .ppm gets a color image, any other a gray PGM image
+      // will throw Error("Image size is out of range!")
+      // or Error("Could not write image file!")
+      void export_image(const std::string& file_name, int pixels) override;
+
+      // in diff mode, a draw writes the whole map the first time
+      // and after the display parameters change, then only lines of
+      // "row column glyph" for each cell that changed, with rows
+      // counted from the top; the objects outside the map are listed
+      // again whenever they change
+      void set_diff_mode(bool) override;
     
   private:
       int size;       // current size of the display
       double scale;   // distance per cell of the display
       Point origin;   // coordinates of the lower-left-hand corner
-      std::map<std::string, Point> name_location_map;
+
+      // the occupied cells, as the index of the cell counted
+      // row by row from the bottom, and the id of an object in it
+      std::vector<std::pair<long long, int>> occupied_cells;
+
+      // the text of the map, an empty row of it, and the objects
+      // outside of it; all are kept between draws so their space is reused
+      std::string frame;
+      std::string empty_row;
+      std::vector<int> outside_ids;
+
+      // make the empty row and reserve the frame for the current size
+      void size_buffers();
+
+      // what was drawn last in diff mode, kept as the cell of each
+      // object by id, the objects in each occupied cell, and
+      // the objects outside the map; valid is false
+      // until a whole map has been drawn in diff mode
+      bool diff_mode;
+      bool diff_map_valid;
+      std::vector<long long> object_cells;
+      std::unordered_map<long long, std::vector<int>> cell_objects;
+      std::set<int, Name_order> outside_set;
+
+      // the cells changed by the moves, with what each one showed
+      typedef std::pair<char, char> Glyph;
+      std::unordered_map<long long, Glyph> changed_cells;
+      std::vector<std::pair<long long, Glyph>> changed_list;
+
+      // draw the whole map, then remember what it shows
+      void draw_diff_base();
+
+      // move the objects listed as moved in the snapshot, which are
+      // those that have moved since the last draw, to their new cells,
+      // and write the cells that changed
+      void draw_diff();
+
+      // the cell of a location, or outside_cell
+      long long get_cell(Point location);
+
+      // take an object out of its cell, or put it into one,
+      // noting the cell as changed
+      void leave_cell(int id, long long cell);
+      void enter_cell(int id, long long cell);
+
+      // what a cell shows for the objects in it
+      Glyph get_glyph(long long cell) const;
     
       // Calculate the cell subscripts
       // corresponding to the location parameter, using the
@@ -84,80 +169,82 @@ class Map_View : public View
 class Sailing_View : public View
 {
   public:
+      // default constructor shows all of the ships in name order
       Sailing_View();
       ~Sailing_View();
     
-      // Save supplied name and fuel for future use in draw() call
-      void update_fuel(const std::string&, double) override;
-    
-      // Save supplied name and speed for future use in draw() call
-      void update_speed(const std::string&, double) override;
-    
-      // Save supplied name and course for future use in draw() call
-      void update_course(const std::string&, double) override;
-    
-      // Remove the name and its location;
-      // no error if the name is not present.
-      void update_remove(const std::string&) override;
-    
-      // prints out the current map
+      // prints out the ships in the Model's World_snapshot chosen by
+      // the settings below, formatted into a buffer and written in one piece
       void draw() override;
     
-      // Discard the saved information -
-      // drawing will show only a empty pattern
+      // nothing about the ships is saved
       void clear() override
-          {ship_data_map.clear();}
+          {}
+
+      // show only the given number of ships with the least fuel,
+      // or with the highest speed, in that order
+      // will throw Error("Number of ships must be positive!")
+      void set_lowest_fuel(int) override;
+      void set_highest_speed(int) override;
+
+      // show only the ships whose names start with the prefix
+      void set_name_prefix(const std::string&) override;
+
+      // show all of the ships again, in name order
+      void set_defaults() override;
     
   private:
-      struct Ship_Data
+      enum Ranking_e
       {
-          double fuel;
-          double speed;
-          double course;
+          BY_NAME,
+          BY_LOW_FUEL,
+          BY_HIGH_SPEED
       };
-      std::map<std::string, Ship_Data> ship_data_map;
+      Ranking_e ranking;
+      int max_ships;              // number shown when ranked
+      std::string name_prefix;    // empty to show every name
+
+      // the ids to be shown and the text of the table,
+      // kept between draws so their space is reused
+      std::vector<int> shown_ids;
+      std::string frame;
+
+      // set the number of ships for a ranking
+      void set_ranking(Ranking_e, int);
 };
 
 class Bridge_View : public View
 {
   public:
-      Bridge_View(const std::string&, Point, double, bool);
+      // construct with the ownship's id
+      explicit Bridge_View(int);
       ~Bridge_View();
     
-      // Save the supplied name and location
-      // for future use in a draw() call
-      // If the name is already present,
-      // the new location replaces the previous one.
-      void update_location(const std::string&, Point) override;
-    
-      // Save supplied name and course for future use in draw() call
-      void update_course(const std::string&, double) override;
-    
-      // Remove the name and its location;
-      // no error if the name is not present.
-      void update_remove(const std::string& name) override;
-    
-      // prints out the current map
+      // prints out what can be seen from the ownship, as found in
+      // the Model's World_snapshot; only the objects within sight
+      // of it are looked at; once the ownship has been removed, the view
+      // stays sunk, even if a ship with the same name is made again
       void draw() override;
 
-      // Discard the saved information -
-      // drawing will show only a empty pattern
+      // nothing about the objects is saved
       void clear() override
-          {name_location_map.clear();}
+          {}
     
   private:
       int x_size;     // grid length of x-coordinate
       int y_size;     // grid length of y-coordinate
       double scale;   // distance per cell of the display
       double origin;   // coordinates of the lower-left-hand corner
-      struct Ownship
-      {
-          std::string name;
-          Point location;
-          double heading;
-          bool sunk;
-      } ownship;
-      std::map<std::string, Point> name_location_map;
+      int ownship_id;
+
+      // the ownship's removal count in the snapshot when the view
+      // was opened, and whether it has been removed since
+      int removal_count;
+      bool sunk;
+
+      // the ids found within sight, kept between draws
+      // so their space is reused
+      std::vector<int> sighted_ids;
     
       // Calculate the x-axis displacement
       // corresponding to the location parameter, using the
@@ -165,8 +252,9 @@ class Bridge_View : public View
       // Return true if the location is within the map, false if not
       bool get_x_coordinate(int&, double);
     
-      // calculate angle needed to see object from ship's bow
-      double calc_angle(Point other);
+      // calculate angle needed to see another object
+      // from the bow of a ship at a location with a heading
+      double calc_angle(Point location, double heading, Point other);
 };
 
 #endif
@@ -1,4 +1,7 @@
 #include "Warship.h"
+#include "Output.h"
+#include "Tick_intents.h"
+#include "Checkpoint.h"
 #include "Utility.h"
 
 using namespace std;
@@ -33,19 +36,61 @@ Warship::update()
 
     if (is_attacking())
     {
-        shared_ptr<Ship> target = target_ptr.lock();
-        
-        if (!is_afloat() || !target || !target->is_afloat())
-        {
-            stop_attack();
-        }
-        else
-        {
-            cout << get_name() << " is attacking " << endl;
-        }
+        Tick_intents::carry_out(Tick_intents::HIT, [this]{attack_target();});
     }
 }
 
+void
+Warship::attack_target()
+{
+    shared_ptr<Ship> target = target_ptr.lock();
+    
+    if (!is_afloat() || !target || !target->is_afloat())
+    {
+        stop_attack();
+    }
+    else
+    {
+        Output::get_Instance().write(Output_sink::WARSHIP_ATTACKING, get_id());
+    }
+}
+
+bool
+Warship::is_dormant() const
+{
+    return (!is_attacking() && Ship::is_dormant());
+}
+
+int
+Warship::get_quiet_updates() const
+{
+    return (is_attacking() ? 0 : Ship::get_quiet_updates());
+}
+
+int
+Warship::get_target_id() const
+{
+    shared_ptr<Ship> target = target_ptr.lock();
+    return (is_attacking() && target) ? target->get_id() : -1;
+}
+
+void
+Warship::save_state(Checkpoint_writer& writer) const
+{
+    Ship::save_state(writer);
+    writer.write_int(warship_state);
+    writer.write_ship(target_ptr.lock());
+}
+
+void
+Warship::restore_state(Checkpoint_reader& reader)
+{
+    Ship::restore_state(reader);
+    int32_t state = reader.read_int();
+    warship_state = (state == ATTACKING) ? ATTACKING : NOT_ATTACKING;
+    target_ptr    = reader.read_ship();
+}
+
 void
 Warship::attack(shared_ptr<Ship> target_ptr_)
 {
@@ -54,7 +99,7 @@ Warship::attack(shared_ptr<Ship> target_ptr_)
         throw Error("Cannot attack!");
     }
 
-    if (target_ptr_->get_name() == get_name())
+    if (target_ptr_->get_id() == get_id())
     {
         throw Error("Warship may not attack itself!");
     }
@@ -62,8 +107,9 @@ Warship::attack(shared_ptr<Ship> target_ptr_)
     target_ptr    = target_ptr_;
     warship_state = ATTACKING;
 
-    cout << get_name() << " will attack "
-         << target_ptr_->get_name() << endl;
+    Output::get_Instance().write(Output_sink::WARSHIP_WILL_ATTACK,
+                                 get_id(),
+                                 target_ptr_->get_id());
 }
 
 void
@@ -77,7 +123,7 @@ Warship::stop_attack()
     warship_state = NOT_ATTACKING;
     target_ptr.reset();
 
-    cout << get_name() << " stopping attack" << endl;
+    Output::get_Instance().write(Output_sink::WARSHIP_STOPPING_ATTACK, get_id());
 }
 
 void
@@ -118,7 +164,7 @@ Warship::fire_at_target()
     
     if (target)
     {
-        cout << get_name() << " fires" << endl;
+        Output::get_Instance().write(Output_sink::WARSHIP_FIRES, get_id());
 
         target->receive_hit(firepower, shared_from_this());
     }
@@ -35,6 +35,18 @@ class Warship : public Ship, public std::enable_shared_from_this<Warship>
       // perform warship-specific behavior
       void update() override;
 
+      // a Warship that is attacking is never dormant,
+      // and each of its updates fires or gives up the attack
+      bool is_dormant() const override;
+      int get_quiet_updates() const override;
+
+      // the ship it is attacking, if any
+      int get_target_id() const override;
+
+      // whether it is attacking, and its target
+      void save_state(Checkpoint_writer&) const override;
+      void restore_state(Checkpoint_reader&) override;
+
       // will throw Error("Cannot attack!") if not Afloat
       // will throw Error("Warship may not attack itself!")
       //     if supplied target is the same as this Warship
@@ -49,6 +61,11 @@ class Warship : public Ship, public std::enable_shared_from_this<Warship>
       // return true if this Warship is in the attacking state
       bool is_attacking() const;
 
+      // the part of an update that deals with the target, while attacking;
+      // it looks at the target, so it is carried out as a HIT step
+      // when the intents of the tick are applied
+      virtual void attack_target();
+
       // fire at the current target
       void fire_at_target();
 
@@ -0,0 +1,118 @@
+#include "Worker_pool.h"
+
+using namespace std;
+
+Worker_pool::Worker_pool(int num_workers) :
+    task(nullptr),
+    count(0),
+    chunk_size(1),
+    next_chunk(0),
+    busy_workers(0),
+    generation(0),
+    stopping(false)
+{
+    for (int i = 0; i < num_workers; ++i)
+    {
+        workers.push_back(thread(&Worker_pool::worker_loop, this));
+    }
+}
+
+Worker_pool::~Worker_pool()
+{
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int
+Worker_pool::default_num_workers()
+{
+    int num_cores = static_cast<int>(thread::hardware_concurrency());
+    return (num_cores > 1) ? num_cores - 1 : 0;
+}
+
+void
+Worker_pool::parallel_for(int count_,
+                          int min_chunk,
+                          const function<void(int, int)>& task_)
+{
+    if (count_ <= 0)
+    {
+        return;
+    }
+
+    // not worth waking the workers for, do it right here
+    int num_threads = static_cast<int>(workers.size()) + 1;
+    if (workers.empty() || count_ < 2 * min_chunk)
+    {
+        task_(0, count_);
+        return;
+    }
+
+    // a few chunks per thread keeps the threads evenly loaded
+    int size = count_ / (4 * num_threads);
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        task         = &task_;
+        count        = count_;
+        chunk_size   = (size > min_chunk) ? size : min_chunk;
+        next_chunk   = 0;
+        busy_workers = static_cast<int>(workers.size());
+        ++generation;
+    }
+    work_ready.notify_all();
+
+    // the calling thread works too
+    run_chunks();
+
+    unique_lock<mutex> lock(pool_mutex);
+    work_done.wait(lock, [this]{return busy_workers == 0;});
+    task = nullptr;
+}
+
+void
+Worker_pool::worker_loop()
+{
+    unsigned long seen_generation = 0;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            work_ready.wait(lock,
+                            [this, seen_generation]
+                            {return stopping || generation != seen_generation;});
+            if (stopping)
+            {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        run_chunks();
+
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            --busy_workers;
+        }
+        work_done.notify_one();
+    }
+}
+
+void
+Worker_pool::run_chunks()
+{
+    int begin;
+    while ((begin = chunk_size * next_chunk++) < count)
+    {
+        int end = begin + chunk_size;
+        (*task)(begin, (end < count) ? end : count);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+/***************************************************************************
+    Worker_pool keeps a set of threads waiting for work,
+    so that a computation over many independent items
+    can be spread across all the cores without creating
+    threads on every tick.
+    parallel_for splits the range [0, count) into chunks
+    and calls the task with the bounds of each chunk; the calling
+    thread works on chunks too, and parallel_for returns only when
+    every chunk is done. The task must only touch data belonging
+    to the items in its own chunk.
+    If the range is too small to be worth splitting, the task
+    is simply called once on the calling thread.
+***************************************************************************/
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+class Worker_pool
+{
+  public:
+      // create a pool with the supplied number of worker threads;
+      // by default, one fewer than the number of cores,
+      // since the calling thread also does work
+      explicit Worker_pool(int num_workers = default_num_workers());
+
+      // stop and join all of the worker threads
+      ~Worker_pool();
+
+      // forbid copy/move, construction/assignment
+      Worker_pool(const Worker_pool&) = delete;
+      Worker_pool(Worker_pool&&) = delete;
+      Worker_pool& operator= (const Worker_pool&) = delete;
+      Worker_pool& operator= (Worker_pool&&) = delete;
+
+      // call task(begin, end) for chunks of at least min_chunk items
+      // covering [0, count), and wait for all of them to finish
+      void parallel_for(int count,
+                        int min_chunk,
+                        const std::function<void(int, int)>& task);
+
+      static int default_num_workers();
+
+  private:
+      std::vector<std::thread> workers;
+      std::mutex pool_mutex;
+      std::condition_variable work_ready;
+      std::condition_variable work_done;
+
+      // the current job, shared by all threads
+      const std::function<void(int, int)>* task;
+      int count;
+      int chunk_size;
+      std::atomic<int> next_chunk;
+      int busy_workers;
+      unsigned long generation;
+      bool stopping;
+
+      // wait for jobs and work on them until the pool is destroyed
+      void worker_loop();
+
+      // take chunks of the current job until there are none left
+      void run_chunks();
+};
+
+#endif
@@ -0,0 +1,199 @@
+#include "World_snapshot.h"
+#include "Name_table.h"
+#include <algorithm>
+
+using namespace std;
+
+// the index is looked at around a single point at a time,
+// over a distance like that a bridge can see
+const double location_cell_size = 20.;
+
+World_snapshot::World_snapshot() :
+    version(0),
+    location_index(location_cell_size),
+    index_made(false)
+{}
+
+void
+World_snapshot::set_location(int id, Point location)
+{
+    make_room(id);
+    locations[id] = location;
+    if (index_made)
+    {
+        if (fields[id] & LOCATION_FIELD)
+        {
+            location_index.move(id, location);
+        }
+        else
+        {
+            location_index.insert(id, location);
+        }
+    }
+    fields[id] |= LOCATION_FIELD;
+    note_moved(id);
+    ++version;
+}
+
+void
+World_snapshot::set_fuel(int id, double fuel)
+{
+    make_ship_data(id);
+    fuels[id] = fuel;
+    ++version;
+}
+
+void
+World_snapshot::set_speed(int id, double speed)
+{
+    make_ship_data(id);
+    speeds[id] = speed;
+    ++version;
+}
+
+void
+World_snapshot::set_course(int id, double course)
+{
+    make_ship_data(id);
+    courses[id] = course;
+    ++version;
+}
+
+void
+World_snapshot::set_removed(int id)
+{
+    if (id >= get_id_limit() || !fields[id])
+    {
+        return;
+    }
+
+    if (index_made)
+    {
+        location_index.remove(id);
+    }
+    fields[id] = 0;
+    ++removal_counts[id];
+    note_moved(id);
+    ++version;
+}
+
+// the columns are copied into the space already held by this
+// snapshot, so copying into the same one each time allocates nothing
+void
+World_snapshot::copy_from(const World_snapshot& other)
+{
+    moved_ids.clear();
+    merge_from(other);
+}
+
+void
+World_snapshot::merge_from(const World_snapshot& other)
+{
+    version   = other.version;
+    fields    = other.fields;
+    locations = other.locations;
+    fuels     = other.fuels;
+    speeds    = other.speeds;
+    courses   = other.courses;
+    removal_counts = other.removal_counts;
+    moved_ids.insert(moved_ids.end(),
+                     other.moved_ids.begin(),
+                     other.moved_ids.end());
+    index_made = false;
+    location_index = Spatial_index(location_cell_size);
+}
+
+void
+World_snapshot::swap(World_snapshot& other)
+{
+    std::swap(version, other.version);
+    fields.swap(other.fields);
+    locations.swap(other.locations);
+    fuels.swap(other.fuels);
+    speeds.swap(other.speeds);
+    courses.swap(other.courses);
+    removal_counts.swap(other.removal_counts);
+    moved_ids.swap(other.moved_ids);
+    moved.swap(other.moved);
+    std::swap(location_index, other.location_index);
+    std::swap(index_made, other.index_made);
+}
+
+// a copy lists its moves without marking them
+void
+World_snapshot::clear_moves()
+{
+    for_each(moved_ids.begin(),
+             moved_ids.end(),
+             [this](int id)
+             {
+                 if (id < static_cast<int>(moved.size()))
+                 {
+                     moved[id] = 0;
+                 }
+             });
+    moved_ids.clear();
+}
+
+void
+World_snapshot::find_within(Point center,
+                            double distance,
+                            vector<int>& ids) const
+{
+    if (!index_made)
+    {
+        for (int id = 0; id < get_id_limit(); ++id)
+        {
+            if (fields[id] & LOCATION_FIELD)
+            {
+                location_index.insert(id, locations[id]);
+            }
+        }
+        index_made = true;
+    }
+    location_index.find_within(center, distance, ids);
+}
+
+// the columns are grown to cover every id handed out so far,
+// so they are not grown again for each new object
+void
+World_snapshot::make_room(int id)
+{
+    if (id < get_id_limit())
+    {
+        return;
+    }
+
+    size_t new_size = max(static_cast<size_t>(id) + 1,
+                          static_cast<size_t>(Name_table::get_Instance().size()));
+    fields.resize(new_size, 0);
+    moved.resize(new_size, 0);
+    locations.resize(new_size);
+    fuels.resize(new_size, 0.);
+    speeds.resize(new_size, 0.);
+    courses.resize(new_size, 0.);
+    removal_counts.resize(new_size, 0);
+}
+
+void
+World_snapshot::make_ship_data(int id)
+{
+    make_room(id);
+    if (!(fields[id] & SHIP_DATA_FIELD))
+    {
+        fields[id] |= SHIP_DATA_FIELD;
+        fuels[id] = 0.;
+        speeds[id] = 0.;
+        courses[id] = 0.;
+    }
+}
+
+void
+World_snapshot::note_moved(int id)
+{
+    if (!moved[id])
+    {
+        moved[id] = 1;
+        moved_ids.push_back(id);
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+/***************************************************************************
+    A World_snapshot holds the latest location of every object and the
+    fuel, speed and course of every ship, in columns indexed by the id
+    of the object's name in the Name_table. There is a single one,
+    kept by the Model, which changes it whenever it notifies of a
+    change; the Views read it when they draw instead of each keeping
+    a copy of their own.
+    The version changes whenever anything in the snapshot does,
+    so a reader can tell whether it has changed since it last looked.
+    A removed object keeps its last values, but is no longer present;
+    the number of times each object has been removed is kept too,
+    so a reader can tell that it went even if it was made again.
+    An index of the locations, for finding the objects near a point,
+    is made the first time it is needed, and kept up to date after that.
+    The snapshot also lists the objects that have moved or gone since
+    the moves were last cleared, for a map that redraws only what
+    has changed.
+    A copy of it can be made to draw from while the Model goes on
+    changing its own; the copy is not changed by notifications, and
+    its index is made again if it is needed.
+***************************************************************************/
+
+#include "Geometry.h"
+#include "Spatial_index.h"
+#include <vector>
+
+class World_snapshot
+{
+  public:
+      World_snapshot();
+
+      // forbid copy/move, construction/assignment;
+      // use copy_from and swap instead
+      World_snapshot(const World_snapshot&) = delete;
+      World_snapshot(World_snapshot&&) = delete;
+      World_snapshot& operator= (const World_snapshot&) = delete;
+      World_snapshot& operator= (World_snapshot&&) = delete;
+
+      // record a change for the object with the id; a ship's fuel,
+      // speed and course are zero until they are first set
+      void set_location(int id, Point location);
+      void set_fuel(int id, double fuel);
+      void set_speed(int id, double speed);
+      void set_course(int id, double course);
+      void set_removed(int id);
+
+      // take all of the values and moves of another snapshot,
+      // reusing the space of this one
+      void copy_from(const World_snapshot& other);
+
+      // take all of the values of a later snapshot, adding
+      // its moves to those of this one, which were not yet drawn
+      void merge_from(const World_snapshot& other);
+
+      // exchange the contents with another snapshot
+      void swap(World_snapshot& other);
+
+      // the ids that have moved or gone since the moves were cleared,
+      // in no particular order; an id may be listed more than once
+      const std::vector<int>& get_moved_ids() const
+          {return moved_ids;}
+      void clear_moves();
+
+      // changes whenever anything in the snapshot changes
+      unsigned long long get_version() const
+          {return version;}
+
+      // every id in the snapshot is less than this
+      int get_id_limit() const
+          {return static_cast<int>(fields.size());}
+
+      // is the object present with a location,
+      // or a ship present with its fuel, speed and course?
+      bool has_location(int id) const
+          {return id < get_id_limit() && (fields[id] & LOCATION_FIELD);}
+      bool has_ship_data(int id) const
+          {return id < get_id_limit() && (fields[id] & SHIP_DATA_FIELD);}
+
+      // the number of times the object has been removed
+      int get_removal_count(int id) const
+          {return id < get_id_limit() ? removal_counts[id] : 0;}
+
+      // the values of an object, which must have been set
+      Point get_location(int id) const
+          {return locations[id];}
+      double get_fuel(int id) const
+          {return fuels[id];}
+      double get_speed(int id) const
+          {return speeds[id];}
+      double get_course(int id) const
+          {return courses[id];}
+
+      // append the ids of the objects present no further than
+      // a distance from a location, in no particular order
+      void find_within(Point center,
+                       double distance,
+                       std::vector<int>& ids) const;
+
+  private:
+      // bits of the fields an object has
+      enum Field_e
+      {
+          LOCATION_FIELD  = 1,
+          SHIP_DATA_FIELD = 2
+      };
+
+      unsigned long long version;
+
+      std::vector<unsigned char> fields;
+      std::vector<Point> locations;
+      std::vector<double> fuels;
+      std::vector<double> speeds;
+      std::vector<double> courses;
+      std::vector<int> removal_counts;
+
+      // the moved ids, and whether each id is listed
+      std::vector<int> moved_ids;
+      std::vector<char> moved;
+
+      // the locations of the objects present, made when first needed
+      mutable Spatial_index location_index;
+      mutable bool index_made;
+
+      // grow the columns to cover the id
+      void make_room(int id);
+
+      // give a ship its fuel, speed and course if it has none
+      void make_ship_data(int id);
+
+      // list the id as moved if it is not already
+      void note_moved(int id);
+};
+
+#endif